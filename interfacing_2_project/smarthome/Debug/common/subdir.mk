@@ -0,0 +1,30 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../common/filter.c \
+../common/hysteresis.c \
+../common/pi_controller.c 
+
+OBJS += \
+./common/filter.o \
+./common/hysteresis.o \
+./common/pi_controller.o 
+
+C_DEPS += \
+./common/filter.d \
+./common/hysteresis.d \
+./common/pi_controller.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+common/%.o: ../common/%.c common/subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -DF_CPU=16000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
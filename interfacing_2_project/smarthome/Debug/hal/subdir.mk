@@ -11,7 +11,8 @@ C_SRCS += \
 ../hal/ldr.c \
 ../hal/led.c \
 ../hal/lm35_sensor.c \
-../hal/pushbutton.c 
+../hal/pushbutton.c \
+../hal/sensor_tables.c 
 
 OBJS += \
 ./hal/buzzer.o \
@@ -21,7 +22,8 @@ OBJS += \
 ./hal/ldr.o \
 ./hal/led.o \
 ./hal/lm35_sensor.o \
-./hal/pushbutton.o 
+./hal/pushbutton.o \
+./hal/sensor_tables.o 
 
 C_DEPS += \
 ./hal/buzzer.d \
@@ -31,7 +33,8 @@ C_DEPS += \
 ./hal/ldr.d \
 ./hal/led.d \
 ./hal/lm35_sensor.d \
-./hal/pushbutton.d 
+./hal/pushbutton.d \
+./hal/sensor_tables.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
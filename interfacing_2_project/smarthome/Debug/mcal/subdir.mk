@@ -5,18 +5,30 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../mcal/adc.c \
+../mcal/ext_int0.c \
 ../mcal/gpio.c \
-../mcal/timer_0.c 
+../mcal/power.c \
+../mcal/timer_0.c \
+../mcal/timer_1.c \
+../mcal/timer_2.c 
 
 OBJS += \
 ./mcal/adc.o \
+./mcal/ext_int0.o \
 ./mcal/gpio.o \
-./mcal/timer_0.o 
+./mcal/power.o \
+./mcal/timer_0.o \
+./mcal/timer_1.o \
+./mcal/timer_2.o 
 
 C_DEPS += \
 ./mcal/adc.d \
+./mcal/ext_int0.d \
 ./mcal/gpio.d \
-./mcal/timer_0.d 
+./mcal/power.d \
+./mcal/timer_0.d \
+./mcal/timer_1.d \
+./mcal/timer_2.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -0,0 +1,30 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../service/scheduler.c \
+../service/soft_timer.c \
+../service/systime.c 
+
+OBJS += \
+./service/scheduler.o \
+./service/soft_timer.o \
+./service/systime.o 
+
+C_DEPS += \
+./service/scheduler.d \
+./service/soft_timer.d \
+./service/systime.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+service/%.o: ../service/%.c service/subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -DF_CPU=16000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
@@ -20,6 +20,8 @@ C_DEPS :=
 # Every subdirectory with source files must be described here
 SUBDIRS := \
 app \
+common \
 hal \
 mcal \
+service \
 
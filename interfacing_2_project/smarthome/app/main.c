@@ -12,85 +12,211 @@
 #include"../hal/dcMotor.h"
 #include"../hal/flameSensor.h"
 #include"../hal/buzzer.h"
+#include"../mcal/adc.h"
+#include"../common/hysteresis.h"
+#include"../common/pi_controller.h"
+#include"../service/scheduler.h"
+#include"../service/soft_timer.h"
+#include<avr/interrupt.h>
+
+/*
+ * Fan policy: the step table (five levels with hysteresis) or a PI loop that holds
+ * the room at FAN_SETPOINT_TENTHS with the full 0-255 duty range.
+ */
+/* #define FAN_PI_MODE */
+#ifndef FAN_PI_MODE
+#define FAN_STEP_MODE
+#endif
+
+/*
+ * Sensor sampling: the background ADC scan, or quiet conversions taken by the sensor
+ * task with the CPU in ADC Noise Reduction sleep. Quiet samples carry no CPU noise,
+ * but the timers stop during each conversion (the PWM output holds and the scheduler
+ * tick is late by as much).
+ */
+/* #define SENSOR_QUIET_MODE */
+
+/* Task periods in milliseconds; the scheduler ticks every millisecond */
+#define FLAME_PERIOD_MS       1
+#ifdef SENSOR_QUIET_MODE
+#define SENSOR_PERIOD_MS      50    /* 17 conversions, 1.8 ms with the timers stopped */
+#else
+#define SENSOR_PERIOD_MS      2     /* about one ADC scan round */
+#endif
+#define CONTROL_PERIOD_MS     10
+#define DISPLAY_PERIOD_MS     200   /* 5 Hz */
+
+/*
+ * Fan and lighting ladders. The control task runs every CONTROL_PERIOD_MS, so the
+ * dwell times are in control updates.
+ */
+#define FAN_DEADBAND_TENTHS   5   /* 0.5 C below a threshold before stepping down */
+#define FAN_MIN_DWELL_UPDATES 6   /* 60 ms per fan step */
+/* PI loop: setpoint, update period (10 updates, 0.1 s) and Q8 gains per tenth */
+#define FAN_SETPOINT_TENTHS   280
+#define FAN_PI_PERIOD_UPDATES 10
+#define FAN_PI_KP             PI_GAIN(4.0)
+#define FAN_PI_KI             PI_GAIN(0.05)
+#define LIGHT_DEADBAND        5   /* percent, about two LDR codes at the dark end */
+#define LIGHT_MIN_DWELL_UPDATES 6
+
 uint8 lightIntensity;
 uint8 g_temperature;
 boolean fan;
+static uint16 g_temperatureTenths;
+static uint8 g_fire;
+/* Channels converted in the background by the ADC scan */
+const uint8 g_adcChannels[] = { LDR_CHANNEL_ID, SENSOR_CHANNEL_ID };
+
+#ifdef FAN_STEP_MODE
+/* Fan steps at 25, 30, 35 and 40 C, with the duty of each level */
+static const uint16 g_fanThresholds[] = { 250, 300, 350, 400 };
+static const uint8 g_fanDuty[] = { 0, 25, 50, 75, 100 };
+static HYSTERESIS g_fanState;
+#else
+static PI_CONTROLLER g_fanPi;
+static uint8 g_fanPiUpdates;
+static uint8 g_fanPiDuty;
+#endif
+/* Lights: all three up to 15 %, then fewer at 16, 51 and 71 % */
+static const uint16 g_lightThresholds[] = { 16, 51, 71 };
+static const uint8 g_lightLeds[] = {
+	LED_MASK(LED_BLUE_1) | LED_MASK(LED_GREEN_2) | LED_MASK(LED_RED_3),
+	LED_MASK(LED_GREEN_2) | LED_MASK(LED_RED_3),
+	LED_MASK(LED_RED_3),
+	0 };
+
+static HYSTERESIS g_lightState;
+
+/* Initializes the fan policy selected at build time */
+static void App_fanInit(void) {
+#ifdef FAN_STEP_MODE
+	Hysteresis_init(&g_fanState, g_fanThresholds, sizeof(g_fanThresholds) / sizeof(uint16),
+			FAN_DEADBAND_TENTHS, FAN_MIN_DWELL_UPDATES);
+#else
+	PiController_init(&g_fanPi, FAN_PI_KP, FAN_PI_KI, 0, 255);
+	g_fanPiUpdates = 0;
+	g_fanPiDuty = 0;
+	DcMotor_setDuty(STOP, 0);
+#endif
+}
+
+/* Runs the fan policy once per control update; the motor is written only when its output changes */
+static void App_fanControl(uint16 a_temperatureTenths) {
+#ifdef FAN_STEP_MODE
+	uint8 l_level;
+
+	if (Hysteresis_update(&g_fanState, a_temperatureTenths)) {
+		l_level = Hysteresis_getLevel(&g_fanState);
+		fan = (l_level != 0);
+		DcMotor_rotate(fan ? CW : STOP, g_fanDuty[l_level]);
+	}
+#else
+	uint8 l_duty;
+
+	if (++g_fanPiUpdates < FAN_PI_PERIOD_UPDATES)
+		return;
+	g_fanPiUpdates = 0;
+	/* Above the setpoint is a positive error and more fan */
+	l_duty = (uint8)PiController_update(&g_fanPi,
+			(sint16)a_temperatureTenths - FAN_SETPOINT_TENTHS);
+	if (l_duty != g_fanPiDuty) {
+		g_fanPiDuty = l_duty;
+		fan = (l_duty != 0);
+		DcMotor_setDuty(fan ? CW : STOP, l_duty);
+	}
+#endif
+}
+
+/* Flame check, 1 kHz. In interrupt mode the INT0 ISR has already switched the buzzer on */
+static void App_flameTask(void) {
+	g_fire = FlameSensor_getValue();
+#ifdef FLAME_SENSOR_POLLING_MODE
+	if (g_fire) {
+		Buzzer_on();
+	} else {
+		Buzzer_off();
+	}
+#endif
+}
+
+/* Reads the sensors; the ADC converts them in the background */
+static void App_sensorTask(void) {
+	lightIntensity = LDR_getLightIntensity();
+#ifdef SENSOR_QUIET_MODE
+	/* Without the scan every LM35 call converts again, so it is read once */
+	g_temperatureTenths = LM35_getTemperatureTenths();
+	g_temperature = (uint8)(g_temperatureTenths / 10);
+#else
+	g_temperature = LM35_getTemperature();
+	g_temperatureTenths = LM35_getTemperatureTenths();
+#endif
+}
+
+/* Lights and fan; the outputs are written on transitions only */
+static void App_controlTask(void) {
+	if (Hysteresis_update(&g_lightState, lightIntensity)) {
+		LED_write(g_lightLeds[Hysteresis_getLevel(&g_lightState)]);
+	}
+	App_fanControl(g_temperatureTenths);
+}
+
+/* Fan line of the screen; a driven fan whose tachometer sees no turn is reported */
+static const char *App_fanStatus(void) {
+#ifdef DCMOTOR_TACHOMETER
+	if (DcMotor_isStalled()) {
+		return "FAN STALLED";
+	}
+#endif
+	return fan == TRUE ? "FAN is ON" : "FAN is OFF";
+}
+
+/* Redraws the screen at 5 Hz; only the characters that changed reach the LCD */
+static void App_displayTask(void) {
+	LCD_bufferClear();
+	if (g_fire) {
+		LCD_bufferString(0, 0, " CRITICAL ALERT");
+		LCD_bufferString(1, 0, "      FIRE");
+	} else {
+		LCD_bufferString(0, 0, App_fanStatus());
+		LCD_bufferString(1, 0, "Temp=");
+		LCD_bufferString(1, LCD_bufferInteger(1, 5, g_temperature), "C");
+		LCD_bufferString(1, 9, "LDR=");
+		LCD_bufferString(1, LCD_bufferInteger(1, 13, lightIntensity), "%");
+	}
+	LCD_flush();
+}
 
 int main() {
 
 	LED_init();
+	/* The scheduler tick and the fan's soft-start ramp run on the software timers */
+	SoftTimer_init();
+	/* Timer 0 first: its overflow triggers the ADC conversions */
+	DcMotor_init();
 	LDR_init();
+#ifdef SENSOR_QUIET_MODE
+	ADC_setQuietMode(TRUE);
+#else
+	ADC_setOversampling(SENSOR_CHANNEL_ID, SENSOR_OVERSAMPLING_BITS);
+	ADC_startScan(g_adcChannels, sizeof(g_adcChannels));
+#endif
 	LCD_init();
-	DcMotor_init();
-	FlameSensor_init();
 	Buzzer_init();
-	for (;;) {
-		lightIntensity = LDR_getLightIntensity();
-		LCD_displayString("LDR=");
-		LCD_intgerToString(lightIntensity);
-		LCD_sendChar('%');
-		LCD_moveCursor(0, 0);
-
-		if (lightIntensity <= 15) {
-			LED_on(LED_BLUE_1);
-			LED_on(LED_GREEN_2);
-			LED_on(LED_RED_3);
-		} else if (lightIntensity >= 16 && lightIntensity <= 50) {
-			LED_off(LED_BLUE_1);
-			LED_on(LED_GREEN_2);
-			LED_on(LED_RED_3);
-		} else if (lightIntensity >= 51 && lightIntensity <= 70) {
-			LED_off(LED_BLUE_1);
-			LED_off(LED_GREEN_2);
-			LED_on(LED_RED_3);
-		} else {
-			LED_off(LED_BLUE_1);
-			LED_off(LED_GREEN_2);
-			LED_off(LED_RED_3);
-		}
-		g_temperature = LM35_getTemperature();
-		if (g_temperature >= 40) {
-			fan = TRUE;
-			DcMotor_rotate(CW, 100);
-		} else if (g_temperature >= 35 && g_temperature < 40) {
-			fan = TRUE;
-			DcMotor_rotate(CW, 75);
-		} else if (g_temperature >= 30 && g_temperature < 35) {
-			fan = TRUE;
-			DcMotor_rotate(CW, 50);
-		} else if (g_temperature >= 25 && g_temperature < 30) {
-			fan = TRUE;
-			DcMotor_rotate(CW, 25);
-		} else {
-			fan = FALSE;
-			DcMotor_rotate(STOP, 0);
-		}
-		if (FlameSensor_getValue()) {
-			Buzzer_on();
-			LCD_moveCursor(0, 0);
-			LCD_displayString(" CRITICAL ALERT");
-			LCD_moveCursor(1, 0);
-			LCD_displayString("      FIRE      ");
-		} else {
-			Buzzer_off();
-			LCD_moveCursor(0, 0);
-			if (fan == TRUE) {
-				LCD_displayString("FAN is ON ");
-			} else {
-				LCD_displayString("FAN is OFF");
-			}
-
-			LCD_moveCursor(1, 0);
-			LCD_displayString("Temp=");
-			LCD_intgerToString(g_temperature);
-			LCD_displayString("C");
-
-			LCD_moveCursor(1, 9);
-			LCD_displayString("LDR=");
-			LCD_intgerToString(lightIntensity);
-			LCD_displayString("%");
-		}
+	FlameSensor_init();
+	App_fanInit();
+	Hysteresis_init(&g_lightState, g_lightThresholds,
+			sizeof(g_lightThresholds) / sizeof(uint16), LIGHT_DEADBAND, LIGHT_MIN_DWELL_UPDATES);
 
+	/* Highest priority first; the control runs one tick after the sensors it uses */
+	Scheduler_init();
+	Scheduler_addTask(App_flameTask, SCHEDULER_MS_TO_TICKS(FLAME_PERIOD_MS), 0, 0);
+	Scheduler_addTask(App_sensorTask, SCHEDULER_MS_TO_TICKS(SENSOR_PERIOD_MS), 0, 1);
+	Scheduler_addTask(App_controlTask, SCHEDULER_MS_TO_TICKS(CONTROL_PERIOD_MS), 1, 2);
+	Scheduler_addTask(App_displayTask, SCHEDULER_MS_TO_TICKS(DISPLAY_PERIOD_MS), 2, 3);
+	sei();
+	Scheduler_start();
+	for (;;) {
+		Scheduler_dispatch();
 	}
 }
-
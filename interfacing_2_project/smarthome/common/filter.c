@@ -0,0 +1,155 @@
+/**
+ * @file filter.c
+ * @brief Streaming filters for sensor samples.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "filter.h"
+
+/**
+ * @brief Puts the smaller of two values in a and the larger in b.
+ */
+#define FILTER_SORT_PAIR(a, b) do { \
+		if ((a) > (b)) { uint16 l_swap = (a); (a) = (b); (b) = l_swap; } \
+	} while (0)
+
+/**
+ * @brief Prepares a moving average.
+ *
+ * @param a_filter The filter instance.
+ * @param a_lengthBits Window of 2^a_lengthBits samples, 0 to FILTER_AVERAGE_MAX_BITS.
+ */
+void Filter_averageInit(FILTER_AVERAGE *a_filter, uint8 a_lengthBits) {
+	if (a_lengthBits > FILTER_AVERAGE_MAX_BITS)
+		a_lengthBits = FILTER_AVERAGE_MAX_BITS;
+	a_filter->lengthBits = a_lengthBits;
+	a_filter->index = 0;
+	a_filter->sum = 0;
+	a_filter->primed = FALSE;
+}
+
+/**
+ * @brief Adds a sample to a moving average.
+ *
+ * @param a_filter The filter instance.
+ * @param a_sample The new sample.
+ * @return The average of the window, rounded.
+ */
+uint16 Filter_averageUpdate(FILTER_AVERAGE *a_filter, uint16 a_sample) {
+	uint8 l_bits = a_filter->lengthBits;
+	uint8 i;
+
+	if (!a_filter->primed) {
+		for (i = 0; i < (1 << l_bits); i++) {
+			a_filter->samples[i] = a_sample;
+		}
+		a_filter->sum = a_sample << l_bits;
+		a_filter->primed = TRUE;
+		return a_sample;
+	}
+
+	/* Swap the oldest sample for the new one in the running sum */
+	a_filter->sum += a_sample - a_filter->samples[a_filter->index];
+	a_filter->samples[a_filter->index] = a_sample;
+	a_filter->index = (a_filter->index + 1) & ((1 << l_bits) - 1);
+
+	return (a_filter->sum + ((1 << l_bits) >> 1)) >> l_bits;
+}
+
+/**
+ * @brief Prepares a median filter.
+ *
+ * @param a_filter The filter instance.
+ * @param a_length Window of 3 or 5 samples (other values give 3).
+ */
+void Filter_medianInit(FILTER_MEDIAN *a_filter, uint8 a_length) {
+	a_filter->length = (a_length == 5) ? 5 : 3;
+	a_filter->index = 0;
+	a_filter->primed = FALSE;
+}
+
+/**
+ * @brief Adds a sample to a median filter.
+ *
+ * @param a_filter The filter instance.
+ * @param a_sample The new sample.
+ * @return The median of the window.
+ */
+uint16 Filter_medianUpdate(FILTER_MEDIAN *a_filter, uint16 a_sample) {
+	uint16 l_a, l_b, l_c, l_d, l_e;
+	uint8 i;
+
+	if (!a_filter->primed) {
+		for (i = 0; i < a_filter->length; i++) {
+			a_filter->samples[i] = a_sample;
+		}
+		a_filter->primed = TRUE;
+		return a_sample;
+	}
+
+	a_filter->samples[a_filter->index] = a_sample;
+	if (++a_filter->index >= a_filter->length)
+		a_filter->index = 0;
+
+	l_a = a_filter->samples[0];
+	l_b = a_filter->samples[1];
+	l_c = a_filter->samples[2];
+	if (a_filter->length == 3) {
+		FILTER_SORT_PAIR(l_a, l_b);
+		FILTER_SORT_PAIR(l_b, l_c);
+		FILTER_SORT_PAIR(l_a, l_b);
+		return l_b;
+	}
+
+	/* Network that leaves the median of five in l_c */
+	l_d = a_filter->samples[3];
+	l_e = a_filter->samples[4];
+	FILTER_SORT_PAIR(l_a, l_b);
+	FILTER_SORT_PAIR(l_d, l_e);
+	FILTER_SORT_PAIR(l_a, l_d);
+	FILTER_SORT_PAIR(l_b, l_e);
+	FILTER_SORT_PAIR(l_b, l_c);
+	FILTER_SORT_PAIR(l_c, l_d);
+	FILTER_SORT_PAIR(l_b, l_c);
+	return l_c;
+}
+
+/**
+ * @brief Prepares an exponential moving average.
+ *
+ * @param a_filter The filter instance.
+ * @param a_shift Smoothing: the output moves 1/2^a_shift of the way to each sample.
+ */
+void Filter_emaInit(FILTER_EMA *a_filter, uint8 a_shift) {
+	a_filter->shift = a_shift;
+	a_filter->state = 0;
+	a_filter->primed = FALSE;
+}
+
+/**
+ * @brief Adds a sample to an exponential moving average.
+ *
+ * @param a_filter The filter instance.
+ * @param a_sample The new sample, up to 16 - shift bits.
+ * @return The smoothed value, rounded.
+ */
+uint16 Filter_emaUpdate(FILTER_EMA *a_filter, uint16 a_sample) {
+	uint8 l_shift = a_filter->shift;
+	uint16 l_half;
+
+	if (!a_filter->primed) {
+		a_filter->state = a_sample << l_shift;
+		a_filter->primed = TRUE;
+		return a_sample;
+	}
+
+	/*
+	 * state/2^shift is the output: take the rounded output away and add the sample.
+	 * Rounding both ways lets it settle on the input from above and from below.
+	 */
+	l_half = (1 << l_shift) >> 1;
+	a_filter->state = a_filter->state - ((a_filter->state + l_half) >> l_shift) + a_sample;
+	return (a_filter->state + l_half) >> l_shift;
+}
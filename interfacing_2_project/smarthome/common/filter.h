@@ -0,0 +1,134 @@
+/**
+ * @file filter.h
+ * @brief Streaming filters for sensor samples.
+ *
+ * Three filters a driver can keep one instance of per channel: a ring-buffer moving
+ * average, a median of the last 3 or 5 samples and a fixed-point exponential moving
+ * average. Each instance is a plain struct owned by the caller (no allocation), and
+ * each update costs the same whatever the length: no loops over the window.
+ *
+ * The first sample after init fills the whole filter, so the output starts at the
+ * input instead of ramping up from 0.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef FILTER_H_
+#define FILTER_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Longest moving average, as a power of two (2^3 = 8 samples).
+ *
+ * The running sum is 16 bits, so 8 samples of up to 13 bits fit.
+ */
+#define FILTER_AVERAGE_MAX_BITS   3
+#define FILTER_AVERAGE_MAX_LENGTH (1 << FILTER_AVERAGE_MAX_BITS)
+
+/**
+ * @brief Longest median window.
+ */
+#define FILTER_MEDIAN_MAX_LENGTH  5
+
+/**
+ * @brief Moving average over the last 2^lengthBits samples.
+ */
+typedef struct {
+	uint16 samples[FILTER_AVERAGE_MAX_LENGTH];
+	uint16 sum;
+	uint8 lengthBits;
+	uint8 index;
+	boolean primed;
+} FILTER_AVERAGE;
+
+/**
+ * @brief Median of the last 3 or 5 samples.
+ */
+typedef struct {
+	uint16 samples[FILTER_MEDIAN_MAX_LENGTH];
+	uint8 length;
+	uint8 index;
+	boolean primed;
+} FILTER_MEDIAN;
+
+/**
+ * @brief Exponential moving average y += (x - y) / 2^shift.
+ *
+ * The state keeps the output with shift fraction bits (x << shift when settled), so
+ * samples of up to 16 - shift bits fit.
+ */
+typedef struct {
+	uint16 state;
+	uint8 shift;
+	boolean primed;
+} FILTER_EMA;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/**
+ * @brief Prepares a moving average.
+ *
+ * @param a_filter The filter instance.
+ * @param a_lengthBits Window of 2^a_lengthBits samples, 0 to FILTER_AVERAGE_MAX_BITS.
+ */
+void Filter_averageInit(FILTER_AVERAGE *a_filter, uint8 a_lengthBits);
+
+/**
+ * @brief Adds a sample to a moving average.
+ *
+ * The sum is updated with the new sample and the one it replaces, so the cost does
+ * not depend on the window length.
+ *
+ * @param a_filter The filter instance.
+ * @param a_sample The new sample.
+ * @return The average of the window, rounded.
+ */
+uint16 Filter_averageUpdate(FILTER_AVERAGE *a_filter, uint16 a_sample);
+
+/**
+ * @brief Prepares a median filter.
+ *
+ * @param a_filter The filter instance.
+ * @param a_length Window of 3 or 5 samples (other values give 3).
+ */
+void Filter_medianInit(FILTER_MEDIAN *a_filter, uint8 a_length);
+
+/**
+ * @brief Adds a sample to a median filter.
+ *
+ * A single outlier (two with a window of 5) never reaches the output. The median is
+ * taken with a fixed compare-exchange network, 3 or 7 comparisons.
+ *
+ * @param a_filter The filter instance.
+ * @param a_sample The new sample.
+ * @return The median of the window.
+ */
+uint16 Filter_medianUpdate(FILTER_MEDIAN *a_filter, uint16 a_sample);
+
+/**
+ * @brief Prepares an exponential moving average.
+ *
+ * @param a_filter The filter instance.
+ * @param a_shift Smoothing: the output moves 1/2^a_shift of the way to each sample,
+ *        a time constant of about 2^a_shift samples.
+ */
+void Filter_emaInit(FILTER_EMA *a_filter, uint8 a_shift);
+
+/**
+ * @brief Adds a sample to an exponential moving average.
+ *
+ * @param a_filter The filter instance.
+ * @param a_sample The new sample, up to 16 - shift bits.
+ * @return The smoothed value, rounded.
+ */
+uint16 Filter_emaUpdate(FILTER_EMA *a_filter, uint16 a_sample);
+
+#endif /* FILTER_H_ */
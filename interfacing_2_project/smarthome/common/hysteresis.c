@@ -0,0 +1,78 @@
+/**
+ * @file hysteresis.c
+ * @brief Multi-level threshold state machine with deadband and minimum dwell.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "hysteresis.h"
+
+/**
+ * @brief Prepares a threshold ladder.
+ *
+ * @param a_state The state machine.
+ * @param a_thresholds Ascending rising thresholds; the array must outlive the state.
+ * @param a_count Number of thresholds (levels are 0 to a_count).
+ * @param a_deadband Fall-back margin below each threshold, in reading units.
+ * @param a_minDwell Updates a level is held after a change (0 for none).
+ */
+void Hysteresis_init(HYSTERESIS *a_state, const uint16 *a_thresholds, uint8 a_count,
+		uint16 a_deadband, uint16 a_minDwell) {
+	a_state->thresholds = a_thresholds;
+	a_state->count = a_count;
+	a_state->deadband = a_deadband;
+	a_state->minDwell = a_minDwell;
+	a_state->dwell = 0;
+	a_state->level = 0;
+	a_state->primed = FALSE;
+}
+
+/**
+ * @brief Feeds a reading and moves to a new level if it calls for one.
+ *
+ * @param a_state The state machine.
+ * @param a_reading The new reading.
+ * @return TRUE if the level changed, FALSE otherwise.
+ */
+boolean Hysteresis_update(HYSTERESIS *a_state, uint16 a_reading) {
+	const uint16 *l_thresholds = a_state->thresholds;
+	uint8 l_level = a_state->level;
+
+	if (a_state->primed) {
+		if (a_state->dwell < a_state->minDwell) {
+			a_state->dwell++;
+			return FALSE;
+		}
+	} else {
+		/* No history yet: plain thresholds from level 0 */
+		l_level = 0;
+	}
+
+	/* Up while the next threshold is reached */
+	while (l_level < a_state->count && a_reading >= l_thresholds[l_level]) {
+		l_level++;
+	}
+	/* Down only once the reading is a deadband below the threshold of this level */
+	while (l_level > 0 && a_state->primed
+			&& (uint32)a_reading + a_state->deadband < l_thresholds[l_level - 1]) {
+		l_level--;
+	}
+
+	if (a_state->primed && l_level == a_state->level) {
+		if (a_state->dwell != 0xFFFF)
+			a_state->dwell++;
+		return FALSE;
+	}
+	a_state->level = l_level;
+	a_state->dwell = 0;
+	a_state->primed = TRUE;
+	return TRUE;
+}
+
+/**
+ * @brief Returns the current level, 0 to the number of thresholds.
+ */
+uint8 Hysteresis_getLevel(const HYSTERESIS *a_state) {
+	return a_state->level;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file hysteresis.h
+ * @brief Multi-level threshold state machine with deadband and minimum dwell.
+ *
+ * Maps a reading onto one of count + 1 levels split by ascending thresholds. A
+ * level is entered going up when the reading reaches its threshold, and left going
+ * down only once the reading drops a deadband below it, so a reading sitting on a
+ * threshold keeps its level. After each change the level is held for a minimum
+ * number of updates. Hysteresis_update() reports a change, so actuators are
+ * written on transitions only.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef HYSTERESIS_H_
+#define HYSTERESIS_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief State of one threshold ladder, owned by the caller.
+ */
+typedef struct {
+	const uint16 *thresholds; /**< Rising thresholds, ascending, count entries */
+	uint16 deadband;          /**< How far below a threshold the reading must fall */
+	uint16 minDwell;          /**< Updates a level is held before it may change */
+	uint16 dwell;             /**< Updates since the last change (saturates) */
+	uint8 count;              /**< Number of thresholds */
+	uint8 level;              /**< Current level, 0 to count */
+	boolean primed;
+} HYSTERESIS;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/**
+ * @brief Prepares a threshold ladder.
+ *
+ * @param a_state The state machine.
+ * @param a_thresholds Ascending rising thresholds; the array must outlive the state.
+ * @param a_count Number of thresholds (levels are 0 to a_count).
+ * @param a_deadband Fall-back margin below each threshold, in reading units.
+ * @param a_minDwell Updates a level is held after a change (0 for none).
+ */
+void Hysteresis_init(HYSTERESIS *a_state, const uint16 *a_thresholds, uint8 a_count,
+		uint16 a_deadband, uint16 a_minDwell);
+
+/**
+ * @brief Feeds a reading and moves to a new level if it calls for one.
+ *
+ * The first reading after init sets the level directly and counts as a change, so
+ * the actuators get their first write. A big step may cross several levels at once.
+ *
+ * @param a_state The state machine.
+ * @param a_reading The new reading.
+ * @return TRUE if the level changed, FALSE otherwise.
+ */
+boolean Hysteresis_update(HYSTERESIS *a_state, uint16 a_reading);
+
+/**
+ * @brief Returns the current level, 0 to the number of thresholds.
+ */
+uint8 Hysteresis_getLevel(const HYSTERESIS *a_state);
+
+#endif /* HYSTERESIS_H_ */
@@ -0,0 +1,72 @@
+/**
+ * @file pi_controller.c
+ * @brief Fixed-point PI controller with output clamping and anti-windup.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "pi_controller.h"
+
+/**
+ * @brief Prepares a controller with its gains and output range; the integral is 0.
+ *
+ * @param a_pi The controller.
+ * @param a_kp Proportional gain, Q8 (see PI_GAIN).
+ * @param a_ki Integral gain per update, Q8.
+ * @param a_outMin Lowest output.
+ * @param a_outMax Highest output.
+ */
+void PiController_init(PI_CONTROLLER *a_pi, sint16 a_kp, sint16 a_ki, sint16 a_outMin,
+		sint16 a_outMax) {
+	a_pi->kp = a_kp;
+	a_pi->ki = a_ki;
+	a_pi->outMin = a_outMin;
+	a_pi->outMax = a_outMax;
+	a_pi->integral = 0;
+}
+
+/**
+ * @brief Runs one controller update; call it at a fixed rate.
+ *
+ * @param a_pi The controller.
+ * @param a_error Measurement minus setpoint, or the other way round, as the sign of
+ *        the gains requires.
+ * @return The clamped output.
+ */
+sint16 PiController_update(PI_CONTROLLER *a_pi, sint16 a_error) {
+	sint32 l_max = (sint32)a_pi->outMax << PI_FRACTION_BITS;
+	sint32 l_min = (sint32)a_pi->outMin << PI_FRACTION_BITS;
+	sint32 l_integral = a_pi->integral + (sint32)a_pi->ki * a_error;
+	sint32 l_output;
+
+	/* The integral alone never needs to leave the output range */
+	if (l_integral > l_max)
+		l_integral = l_max;
+	else if (l_integral < l_min)
+		l_integral = l_min;
+
+	l_output = (sint32)a_pi->kp * a_error + l_integral;
+	if (l_output > l_max) {
+		l_output = l_max;
+		/* Saturated high: only let the integral come down */
+		if (l_integral > a_pi->integral)
+			l_integral = a_pi->integral;
+	} else if (l_output < l_min) {
+		l_output = l_min;
+		if (l_integral < a_pi->integral)
+			l_integral = a_pi->integral;
+	}
+	a_pi->integral = l_integral;
+
+	/* Round to the nearest output step; l_output is within the range, so >= l_min */
+	return (sint16)((l_output - l_min + (1 << (PI_FRACTION_BITS - 1))) >> PI_FRACTION_BITS)
+			+ a_pi->outMin;
+}
+
+/**
+ * @brief Clears the integral, e.g. when the loop is switched back on.
+ */
+void PiController_reset(PI_CONTROLLER *a_pi) {
+	a_pi->integral = 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file pi_controller.h
+ * @brief Fixed-point PI controller with output clamping and anti-windup.
+ *
+ * The gains are Q8 fixed point (256 is a gain of 1), the integral is kept in Q8 as
+ * well and everything runs on 32-bit integers. The output is clamped to a range,
+ * and the integral stops growing while the output sits on a limit in the direction
+ * of the error (conditional integration), so it does not wind up while the
+ * actuator is saturated and the loop recovers without overshoot from the limits.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef PI_CONTROLLER_H_
+#define PI_CONTROLLER_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Fraction bits of the gains and of the integral.
+ */
+#define PI_FRACTION_BITS 8
+
+/**
+ * @brief Converts a real gain to the Q8 value the controller takes.
+ */
+#define PI_GAIN(gain) ((sint16) ((gain) * (1 << PI_FRACTION_BITS) + 0.5))
+
+/**
+ * @brief State of one controller, owned by the caller.
+ */
+typedef struct {
+	sint32 integral; /**< Integral term in Q8 output units */
+	sint16 kp;       /**< Proportional gain, Q8, output units per error unit */
+	sint16 ki;       /**< Integral gain, Q8, output units per error unit per update */
+	sint16 outMin;
+	sint16 outMax;
+} PI_CONTROLLER;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/**
+ * @brief Prepares a controller with its gains and output range; the integral is 0.
+ *
+ * @param a_pi The controller.
+ * @param a_kp Proportional gain, Q8 (see PI_GAIN).
+ * @param a_ki Integral gain per update, Q8.
+ * @param a_outMin Lowest output.
+ * @param a_outMax Highest output.
+ */
+void PiController_init(PI_CONTROLLER *a_pi, sint16 a_kp, sint16 a_ki, sint16 a_outMin,
+		sint16 a_outMax);
+
+/**
+ * @brief Runs one controller update; call it at a fixed rate.
+ *
+ * @param a_pi The controller.
+ * @param a_error Measurement minus setpoint, or the other way round, as the sign of
+ *        the gains requires.
+ * @return The clamped output.
+ */
+sint16 PiController_update(PI_CONTROLLER *a_pi, sint16 a_error);
+
+/**
+ * @brief Clears the integral, e.g. when the loop is switched back on.
+ */
+void PiController_reset(PI_CONTROLLER *a_pi);
+
+#endif /* PI_CONTROLLER_H_ */
@@ -109,7 +109,11 @@ typedef signed short          sint16;         /**< Signed 16-bit integer (-32768
  *
  * This typedef defines an unsigned 32-bit integer, representing values from 0 to 4294967295.
  */
+#ifndef HOST_SIM
 typedef unsigned long         uint32;         /**< Unsigned 32-bit integer (0 to 4294967295). */
+#else
+typedef unsigned int          uint32;         /**< long is 64-bit on the x86-64 host build. */
+#endif
 
 /**
  * @typedef sint32_t
@@ -117,7 +121,11 @@ typedef unsigned long         uint32;         /**< Unsigned 32-bit integer (0 to
  *
  * This typedef defines a signed 32-bit integer, representing values from -2147483648 to +2147483647.
  */
+#ifndef HOST_SIM
 typedef signed long           sint32;         /**< Signed 32-bit integer (-2147483648 to +2147483647). */
+#else
+typedef signed int            sint32;         /**< long is 64-bit on the x86-64 host build. */
+#endif
 
 /**
  * @typedef uint64_t
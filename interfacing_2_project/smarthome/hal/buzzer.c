@@ -4,24 +4,24 @@
 
 void Buzzer_init() {
 
-		GPIO_ARR_setPinDirection(BUZZER_PIN, PIN_OUTPUT);
+		GPIO_STATIC_setPinDirection(BUZZER_PIN, PIN_OUTPUT);
 
 }
 
 void Buzzer_on() {
 #ifdef BUZZER_POSTIVE_LOGIC
-	GPIO_ARR_setPinState(BUZZER_PIN, LOGIC_HIGH);
+	GPIO_STATIC_setPinState(BUZZER_PIN, HIGH);
 #else
-	GPIO_ARR_setPinState(BUZZER_PIN,LOGIC_LOW);
+	GPIO_STATIC_setPinState(BUZZER_PIN, LOW);
 #endif
 
 }
 
 void Buzzer_off() {
 #ifdef BUZZER_POSTIVE_LOGIC
-	GPIO_ARR_setPinState(BUZZER_PIN, LOGIC_LOW);
+	GPIO_STATIC_setPinState(BUZZER_PIN, LOW);
 #else
-	GPIO_ARR_setPinState(BUZZER_PIN,LOGIC_HIGH);
+	GPIO_STATIC_setPinState(BUZZER_PIN, HIGH);
 #endif
 
 }
@@ -5,39 +5,277 @@
  *      Author: MSI
  */
 #include"../mcal/timer_0.h"
+#include"../mcal/timer_1.h"
 #include"../mcal/gpio.h"
 #include"dcMotor.h"
 #include"../common/std_types.h"
-#include"../common/common_Macros.h"
+#include"../common/common_macros.h"
+#include<avr/io.h>
+#include<avr/interrupt.h>
+#ifdef DCMOTOR_SOFT_START
+#include"../service/soft_timer.h"
+
+/* Whole duty steps per 1 ms tick, and the rest carried over from tick to tick */
+#define DCMOTOR_RAMP_STEP (DCMOTOR_DUTY_MAX / DCMOTOR_RAMP_MS)
+#define DCMOTOR_RAMP_REMAINDER (DCMOTOR_DUTY_MAX % DCMOTOR_RAMP_MS)
+
+/* Set by the caller, reached by the ramp */
+static DCMOTOR_STATE g_targetState = STOP;
+static uint16 g_targetDuty;
+/* What the bridge and the PWM output now */
+static DCMOTOR_STATE g_state = STOP;
+static uint16 g_duty;
+static uint16 g_rampError;
+/* Direction driven before the last stop, and the coast time left since then */
+static DCMOTOR_STATE g_lastDirection = STOP;
+static uint16 g_coastTicks;
+static SoftTimer g_rampTimer;
+#endif
+#ifdef DCMOTOR_TACHOMETER
+#include"../service/systime.h"
+
+#define DCMOTOR_TACH_AVERAGE_MASK (DCMOTOR_TACH_AVERAGE - 1)
+#define DCMOTOR_TACH_MIN_PERIOD_US (60000000UL / (DCMOTOR_TACH_MAX_RPM * DCMOTOR_TACH_PULSES_PER_REV))
+#define DCMOTOR_TACH_STALL_US (DCMOTOR_TACH_STALL_MS * 1000UL)
+/* CPU cycles per Timer 1 count */
+#define DCMOTOR_TACH_CYCLES_PER_COUNT 8
+
+#if (DCMOTOR_TACH_AVERAGE & DCMOTOR_TACH_AVERAGE_MASK) != 0
+#error "DCMOTOR_TACH_AVERAGE must be a power of two"
+#endif
+
+/* Last periods in microseconds, and their sum over the g_tachCount valid ones */
+static uint32 g_tachPeriods[DCMOTOR_TACH_AVERAGE];
+static uint32 g_tachSum;
+static uint8 g_tachIndex;
+static uint8 g_tachCount;
+/* Time of the last accepted edge, valid while the fan is seen turning */
+static uint32 g_tachLastEdge;
+static boolean g_tachTurning;
+static uint16 g_tachMaxLatency;
+/* Whether the fan is driven, and since when; the ramp tick writes them with DCMOTOR_SOFT_START */
+static volatile boolean g_driven;
+static volatile uint32 g_drivenSince;
+
+/* Timer 1 capture callback: one tach period per falling edge */
+static void DcMotor_onTachEdge(void) {
+	uint16 l_capture = Timer1_getCapture();
+	uint32 l_edge = SysTime_microsAt(l_capture);
+	uint32 l_period = l_edge - g_tachLastEdge;
+	uint16 l_latency;
+	uint8 i;
+
+	if (!g_tachTurning || l_period > DCMOTOR_TACH_STALL_US) {
+		/* First edge after a stop: nothing to time it against */
+		for (i = 0; i < DCMOTOR_TACH_AVERAGE; i++) {
+			g_tachPeriods[i] = 0;
+		}
+		g_tachTurning = TRUE;
+		g_tachIndex = 0;
+		g_tachCount = 0;
+		g_tachSum = 0;
+		g_tachLastEdge = l_edge;
+	} else if (l_period >= DCMOTOR_TACH_MIN_PERIOD_US) {
+		g_tachSum += l_period - g_tachPeriods[g_tachIndex];
+		g_tachPeriods[g_tachIndex] = l_period;
+		g_tachIndex = (g_tachIndex + 1) & DCMOTOR_TACH_AVERAGE_MASK;
+		if (g_tachCount < DCMOTOR_TACH_AVERAGE) {
+			g_tachCount++;
+		}
+		g_tachLastEdge = l_edge;
+	}
+	l_latency = Timer1_getCount() - l_capture;
+	if (l_latency > g_tachMaxLatency) {
+		g_tachMaxLatency = l_latency;
+	}
+}
+
+/* Starts the input capture on the tach pin */
+static void DcMotor_tachInit(void) {
+	SysTime_init();
+	g_tachTurning = FALSE;
+	g_tachMaxLatency = 0;
+	g_driven = FALSE;
+	GPIO_STATIC_setPinDirection(DCMOTOR_TACH, PIN_INPUT_PULLUP);
+	Timer1_setCallback(TIMER1_EVENT_CAPTURE, DcMotor_onTachEdge);
+	Timer1_setCaptureEdge(TIMER1_CAPTURE_FALLING, TRUE);
+	Timer1_setEventInterrupt(TIMER1_EVENT_CAPTURE, TRUE);
+}
+#endif
+#if DCMOTOR_PWM_TIMER == DCMOTOR_TIMER1
+/* Fast PWM with ICR1 as TOP, no prescaler: TOP + 1 = F_CPU / DCMOTOR_PWM_HZ */
+const Timer1_Config timer1_config = { .mode = TIMER1_MODE_FAST_PWM, .clockSource =
+		TIMER1_PRESCALER_1, .top = DCMOTOR_DUTY_MAX };
+#else
+/* The PWM starts at duty 0, so the motor never sees full drive before the first ramp */
 Timer0_Config timer0_config = { .mode = TIMER0_MODE_FAST_PWM, .clockSource =
 		TIMER0_PRESCALER_8, .compareOutputMode = TIMER0_COMPARE_CLEAR,.interrupt= FALSE , .tick =
-		255, .intialCount = 0
+		0, .intialCount = 0, .adcTrigger = DCMOTOR_ADC_TRIGGER
 
 };
-void DcMotor_init() {
-	Timer0_init(&timer0_config);
-	GPIO_ARR_setPinDirection(DCMOTOR_IN_1, PIN_OUTPUT);
-	GPIO_ARR_setPinDirection(DCMOTOR_IN_2, PIN_OUTPUT);
-	GPIO_ARR_setPinDirection(DCMOTOR_E1, PIN_OUTPUT);
-
-}
-void DcMotor_rotate(DCMOTOR_STATE a_state, uint8 a_speed) {
+#endif
+/* Writes the bridge and the PWM at once */
+static void DcMotor_apply(DCMOTOR_STATE a_state, uint16 a_duty) {
+	GPIO_Batch l_batch;
+	GPIO_BATCH_init(&l_batch);
 	switch (a_state) {
 	case CW:
-		GPIO_ARR_setPinState(DCMOTOR_IN_1, LOGIC_HIGH);
-		GPIO_ARR_setPinState(DCMOTOR_IN_2, LOGIC_LOW);
+		GPIO_BATCH_setPinState(&l_batch, DCMOTOR_IN_1, HIGH);
+		GPIO_BATCH_setPinState(&l_batch, DCMOTOR_IN_2, LOW);
 		break;
 	case ACW:
-		GPIO_ARR_setPinState(DCMOTOR_IN_2, LOGIC_HIGH);
-		GPIO_ARR_setPinState(DCMOTOR_IN_1, LOGIC_LOW);
+		GPIO_BATCH_setPinState(&l_batch, DCMOTOR_IN_1, LOW);
+		GPIO_BATCH_setPinState(&l_batch, DCMOTOR_IN_2, HIGH);
 		break;
 	case STOP:
-		GPIO_ARR_setPinState(DCMOTOR_IN_1, LOGIC_LOW);
-		GPIO_ARR_setPinState(DCMOTOR_IN_2, LOGIC_LOW);
+		GPIO_BATCH_setPinState(&l_batch, DCMOTOR_IN_1, LOW);
+		GPIO_BATCH_setPinState(&l_batch, DCMOTOR_IN_2, LOW);
 		break;
 	};
-	uint8 l_duty = MAP(a_speed, 0, 100, 0, 255);
-	Timer0_setDutyCycle(l_duty);
+	/* IN_1 and IN_2 share a port, so both change in the same write */
+	GPIO_BATCH_apply(&l_batch);
+#if DCMOTOR_PWM_TIMER == DCMOTOR_TIMER1
+	Timer1_setDutyCycle(TIMER1_CHANNEL_A, a_duty);
+#else
+	Timer0_setDutyCycle((uint8) a_duty);
+#endif
+#ifdef DCMOTOR_TACHOMETER
+	if (a_state == STOP || a_duty == 0) {
+		g_driven = FALSE;
+	} else if (!g_driven) {
+		g_driven = TRUE;
+		g_drivenSince = SysTime_millis();
+	}
+#endif
+
+}
+void DcMotor_init() {
+#if DCMOTOR_PWM_TIMER == DCMOTOR_TIMER1
+	Timer1_init(&timer1_config);
+	/* OC1A is disconnected at duty 0 and the pin falls back to PORT: keep it low */
+	GPIO_STATIC_setPinState(DCMOTOR_E1, LOW);
+#else
+	Timer0_init(&timer0_config);
+#endif
+	GPIO_STATIC_setPinDirection(DCMOTOR_IN_1, PIN_OUTPUT);
+	GPIO_STATIC_setPinDirection(DCMOTOR_IN_2, PIN_OUTPUT);
+	GPIO_STATIC_setPinDirection(DCMOTOR_E1, PIN_OUTPUT);
+#ifdef DCMOTOR_TACHOMETER
+	DcMotor_tachInit();
+#endif
+	/* Bridge off until a duty is set */
+	DcMotor_apply(STOP, 0);
+
+}
+void DcMotor_rotate(DCMOTOR_STATE a_state, uint8 a_speed) {
+	DcMotor_setDuty(a_state, MAP(a_speed, 0, 100, 0, 255));
+}
+void DcMotor_setDuty(DCMOTOR_STATE a_state, uint8 a_duty) {
+	DcMotor_setDutyHighRes(a_state, MAP((uint32) a_duty, 0, 255, 0, DCMOTOR_DUTY_MAX));
+}
+#ifdef DCMOTOR_SOFT_START
+/* 1 ms ramp tick: slews the duty, stops and coasts before a reversal, and
+ * stops itself once the target is reached */
+static void DcMotor_rampTick(void) {
+	uint16 l_target = g_targetDuty;
+	uint16 l_step = DCMOTOR_RAMP_STEP;
 
+	if (g_coastTicks != 0) {
+		g_coastTicks--;
+	}
+	/* Down to 0 first when the direction has to change */
+	if (g_state != g_targetState) {
+		l_target = 0;
+	}
+	if (g_duty != l_target) {
+		g_rampError += DCMOTOR_RAMP_REMAINDER;
+		if (g_rampError >= DCMOTOR_RAMP_MS) {
+			g_rampError -= DCMOTOR_RAMP_MS;
+			l_step++;
+		}
+		if (g_duty < l_target) {
+			g_duty = (l_target - g_duty > l_step) ? g_duty + l_step : l_target;
+		} else {
+			g_duty = (g_duty - l_target > l_step) ? g_duty - l_step : l_target;
+		}
+		DcMotor_apply(g_state, g_duty);
+	} else if (g_state != STOP && g_state != g_targetState) {
+		/* Bridge off: the motor coasts down before anything drives it again */
+		g_lastDirection = g_state;
+		g_state = STOP;
+		g_coastTicks = DCMOTOR_COAST_MS;
+		DcMotor_apply(STOP, 0);
+	} else if (g_state != g_targetState) {
+		/* Started from a stop; the other way only once the coast is over */
+		if (g_targetState == g_lastDirection || g_coastTicks == 0) {
+			g_state = g_targetState;
+			DcMotor_apply(g_state, 0);
+		}
+	} else if (g_coastTicks == 0) {
+		SoftTimer_stop(&g_rampTimer);
+	}
 }
+#endif
+void DcMotor_setDutyHighRes(DCMOTOR_STATE a_state, uint16 a_duty) {
+#ifdef DCMOTOR_SOFT_START
+	uint8 l_sreg = SREG;
 
+	if (a_duty > DCMOTOR_DUTY_MAX) {
+		a_duty = DCMOTOR_DUTY_MAX;
+	}
+	cli();
+	g_targetState = a_state;
+	g_targetDuty = (a_state == STOP) ? 0 : a_duty;
+	if (!SoftTimer_isRunning(&g_rampTimer)) {
+		SoftTimer_start(&g_rampTimer, DcMotor_rampTick, 1, 1);
+	}
+	SREG = l_sreg;
+#else
+	DcMotor_apply(a_state, a_duty);
+#endif
+}
+#ifdef DCMOTOR_TACHOMETER
+/* Number of periods in g_tachSum, 0 once no edge came for DCMOTOR_TACH_STALL_MS.
+ * Interrupts must be disabled */
+static uint8 DcMotor_tachCount(void) {
+	if (g_tachTurning && SysTime_micros() - g_tachLastEdge > DCMOTOR_TACH_STALL_US) {
+		g_tachTurning = FALSE;
+	}
+	return g_tachTurning ? g_tachCount : 0;
+}
+uint16 DcMotor_getRpm(void) {
+	uint8 l_sreg = SREG;
+	uint32 l_sum;
+	uint8 l_count;
+
+	cli();
+	l_sum = g_tachSum;
+	l_count = DcMotor_tachCount();
+	SREG = l_sreg;
+	if (l_count == 0) {
+		return 0;
+	}
+	/* rpm = 60 s / (pulses per turn * mean period) */
+	return (uint16) ((60000000UL / DCMOTOR_TACH_PULSES_PER_REV) * l_count / l_sum);
+}
+boolean DcMotor_isStalled(void) {
+	uint8 l_sreg = SREG;
+	boolean l_stalled;
+
+	/* One snapshot of the drive state and the tach, so a ramp tick cannot come between */
+	cli();
+	l_stalled = g_driven && DcMotor_tachCount() == 0
+			&& SysTime_millis() - g_drivenSince >= DCMOTOR_TACH_SPIN_UP_MS;
+	SREG = l_sreg;
+	return l_stalled;
+}
+uint16 DcMotor_getTachMaxLatencyCycles(void) {
+	uint8 l_sreg = SREG;
+	uint16 l_counts;
+
+	cli();
+	l_counts = g_tachMaxLatency;
+	SREG = l_sreg;
+	return l_counts * DCMOTOR_TACH_CYCLES_PER_COUNT;
+}
+#endif
@@ -10,7 +10,61 @@
 #include"../common/std_types.h"
 #define DCMOTOR_IN_1 GPIO_PB0
 #define DCMOTOR_IN_2 GPIO_PB1
+
+/*
+ * PWM backend: Timer 0 fast PWM on OC0 (PB3) at 7.8 kHz with 256 duty steps, or
+ * Timer 1 fast PWM with ICR1 as TOP on OC1A (PD5) at DCMOTOR_PWM_HZ, above the
+ * audible range and with DCMOTOR_DUTY_MAX + 1 steps (640 at 25 kHz). Timer 1 is
+ * then the motor's alone: its timebase stops working, so the tachometer is left
+ * out.
+ */
+#define DCMOTOR_TIMER0 0
+#define DCMOTOR_TIMER1 1
+#define DCMOTOR_PWM_TIMER DCMOTOR_TIMER0
+#define DCMOTOR_PWM_HZ 25000UL
+
+#if DCMOTOR_PWM_TIMER == DCMOTOR_TIMER1
+#define DCMOTOR_E1 GPIO_PD5
+/* TOP of the Timer 1 PWM with no prescaler */
+#define DCMOTOR_DUTY_MAX ((uint16) (F_CPU / DCMOTOR_PWM_HZ - 1))
+#else
 #define DCMOTOR_E1 GPIO_PB3
+#define DCMOTOR_DUTY_MAX 255
+/* Timer 0 event that starts the ADC conversions, so samples keep a fixed phase to
+ * the motor switching: the sample is taken 2 ADC clocks (16 us) after OC0 goes high.
+ * TIMER0_ADC_TRIGGER_NONE leaves the conversions software started */
+#define DCMOTOR_ADC_TRIGGER TIMER0_ADC_TRIGGER_OVERFLOW
+#endif
+
+/*
+ * Tachometer: the fan's open-collector sense output on ICP1 (PD6), pulled up
+ * internally, timed by the Timer 1 input capture on its falling edges. The speed is
+ * averaged over the last DCMOTOR_TACH_AVERAGE periods; no edge for
+ * DCMOTOR_TACH_STALL_MS reads as 0 rpm. Edges closer than DCMOTOR_TACH_MAX_RPM
+ * allows are taken as glitches, so a fan faster than that reads low. Comment out DCMOTOR_TACHOMETER for a fan without
+ * a sense wire. It needs Timer 1 in normal mode, so it only comes with the Timer 0 PWM.
+ */
+#if DCMOTOR_PWM_TIMER == DCMOTOR_TIMER0
+#define DCMOTOR_TACHOMETER
+#endif
+#define DCMOTOR_TACH GPIO_PD6
+#define DCMOTOR_TACH_PULSES_PER_REV 2
+#define DCMOTOR_TACH_AVERAGE 4     /* a power of two */
+#define DCMOTOR_TACH_STALL_MS 500
+#define DCMOTOR_TACH_SPIN_UP_MS 1500 /* time to give a fan that starts before a stall */
+#define DCMOTOR_TACH_MAX_RPM 20000UL
+
+/*
+ * Soft start: the set functions only store the target and return. A 1 ms software
+ * timer (soft_timer.h, started by SoftTimer_init() before DcMotor_init()) slews the
+ * duty toward it, DCMOTOR_RAMP_MS for a change from 0 to full duty, so the motor
+ * never draws an inrush current spike. A reversal ramps down to 0 and leaves the
+ * bridge off for DCMOTOR_COAST_MS before driving the other way. Comment out
+ * DCMOTOR_SOFT_START to write the duty at once.
+ */
+#define DCMOTOR_SOFT_START
+#define DCMOTOR_RAMP_MS 500
+#define DCMOTOR_COAST_MS 200
 
 typedef enum {
 	CW, ACW, STOP
@@ -19,4 +73,18 @@ typedef enum {
 void DcMotor_init();
 
 void DcMotor_rotate( DCMOTOR_STATE, uint8 speed);
+/* Same as DcMotor_rotate() with a duty of 0-255 */
+void DcMotor_setDuty(DCMOTOR_STATE a_state, uint8 a_duty);
+/* Same with the full resolution of the backend: duty 0-DCMOTOR_DUTY_MAX */
+void DcMotor_setDutyHighRes(DCMOTOR_STATE a_state, uint16 a_duty);
+#ifdef DCMOTOR_TACHOMETER
+/* Measured fan speed in rpm, 0 when stopped or stalled */
+uint16 DcMotor_getRpm(void);
+/* TRUE if the fan is driven but has not turned for DCMOTOR_TACH_STALL_MS, after
+ * DCMOTOR_TACH_SPIN_UP_MS to start */
+boolean DcMotor_isStalled(void);
+/* Longest time from a tach edge to the end of its interrupt, in CPU cycles (8 per
+ * Timer 1 count). A new edge before that time would overwrite the capture */
+uint16 DcMotor_getTachMaxLatencyCycles(void);
+#endif
 #endif /* DCMOTOR_H_ */
@@ -1,25 +1,118 @@
 #include "flameSensor.h"
+#include "buzzer.h"
 #include "../mcal/gpio.h"
+#ifdef FLAME_SENSOR_INTERRUPT_MODE
+#include "../mcal/ext_int0.h"
+#include "../mcal/timer_0.h"
+#include <avr/interrupt.h>
+
+/* Alarm latched by the INT0 callback, released by FlameSensor_getValue() */
+static volatile boolean g_flameAlarm = FALSE;
+static volatile uint16 g_responseCycles = 0;
+static volatile uint16 g_maxResponseCycles = 0;
+
+/**
+ * @brief INT0 callback: latches the alarm and switches the buzzer on.
+ *
+ * The buzzer is written first; the time stamps around it only cost two TCNT0 reads.
+ * The path from the INT0 edge to the first stamp cannot be timed in software (the
+ * flag is gone once the vector runs), so its fixed cost is added as a constant.
+ * Counts are converted with the prescaler Timer 0 is actually running at.
+ */
+static void FlameSensor_onInt0(void) {
+    uint8 l_start = Timer0_getCount();
+    Buzzer_on();
+    uint8 l_end = Timer0_getCount();
+    uint16 l_cyclesPerCount = Timer0_getCyclesPerCount();
+    uint32 l_cycles;
+
+    g_flameAlarm = TRUE;
+    if (l_cyclesPerCount == 0) {
+        /* Timer 0 stopped: nothing was measured */
+        return;
+    }
+    l_cycles = FLAME_INT0_ENTRY_CYCLES + (uint32) (uint8) (l_end - l_start) * l_cyclesPerCount;
+    g_responseCycles = (l_cycles > 0xFFFF) ? 0xFFFF : (uint16) l_cycles;
+    if (g_responseCycles > g_maxResponseCycles) {
+        g_maxResponseCycles = g_responseCycles;
+    }
+}
+#endif
 
 /**
  * @brief Initializes the flame sensor pin .
  *
- * Configures the flame sensor pin as an input pin with GPIO_ARR_setPinDirection().
+ * Configures the flame sensor pin as an input pin with GPIO_STATIC_setPinDirection().
+ * In interrupt mode INT0 is armed on the rising edge, and a flame that is already
+ * present at start-up is latched straight away since it will not produce an edge.
  */
 void FlameSensor_init() {
 
-    GPIO_ARR_setPinDirection(GPIO_PD2, PIN_INPUT);
+    GPIO_STATIC_setPinDirection(FLAME_PIN, PIN_INPUT);
+#ifdef FLAME_SENSOR_INTERRUPT_MODE
+    INT0_setCallback(FlameSensor_onInt0);
+    INT0_init(INT0_RISING_EDGE);
+    if (GPIO_STATIC_readPin(FLAME_PIN)) {
+        g_flameAlarm = TRUE;
+        Buzzer_on();
+    }
+#endif
 }
 
 /**
  * @brief Reads the value from the flame sensor.
  *
- * Reads the digital value from the flame sensor pin and returns the result.
- * The pin value is either HIGH (flame detected) or LOW (no flame detected).
+ * Polling mode: reads the digital value from the flame sensor pin and returns the result.
+ * Interrupt mode: returns the latched alarm. Once the pin reads LOW again the latch and
+ * the buzzer are released atomically, so an edge arriving meanwhile is never lost.
+ * A HIGH pin with no alarm latched means the edge was missed, which happens while ADC
+ * Noise Reduction sleep stops the I/O clock, so the alarm is latched here instead.
  *
  * @return The state of the flame sensor pin (HIGH or LOW).
  */
 uint8 FlameSensor_getValue() {
+#ifdef FLAME_SENSOR_INTERRUPT_MODE
+    uint8 l_alarm;
+    uint8 l_sreg = SREG;
 
-    return GPIO_ARR_readPin(GPIO_PD2);
+    cli();
+    if (g_flameAlarm && !GPIO_STATIC_readPin(FLAME_PIN)) {
+        g_flameAlarm = FALSE;
+        Buzzer_off();
+    } else if (!g_flameAlarm && GPIO_STATIC_readPin(FLAME_PIN)) {
+        g_flameAlarm = TRUE;
+        Buzzer_on();
+    }
+    l_alarm = g_flameAlarm;
+    SREG = l_sreg;
+    return l_alarm;
+#else
+    return GPIO_STATIC_readPin(FLAME_PIN);
+#endif
+}
+
+#ifdef FLAME_SENSOR_INTERRUPT_MODE
+/**
+ * @brief Returns the response time of the last alarm in CPU cycles.
+ */
+uint16 FlameSensor_getResponseCycles(void) {
+    uint16 l_cycles;
+    uint8 l_sreg = SREG;
+    cli();
+    l_cycles = g_responseCycles;
+    SREG = l_sreg;
+    return l_cycles;
+}
+
+/**
+ * @brief Returns the longest response time seen since initialization, in CPU cycles.
+ */
+uint16 FlameSensor_getMaxResponseCycles(void) {
+    uint16 l_cycles;
+    uint8 l_sreg = SREG;
+    cli();
+    l_cycles = g_maxResponseCycles;
+    SREG = l_sreg;
+    return l_cycles;
 }
+#endif
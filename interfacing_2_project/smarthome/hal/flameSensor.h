@@ -1,8 +1,10 @@
 /**
  * @file flame_sensor.h
- * @brief Driver for the flame sensor module using polling technique.
+ * @brief Driver for the flame sensor module using polling or the INT0 interrupt.
  *
- * This file provides functions to initialize the flame sensor and read the sensor value using GPIO_ARR.
+ * This file provides functions to initialize the flame sensor and read the sensor value.
+ * In interrupt mode a rising edge on PD2 (INT0) latches the alarm and switches the
+ * buzzer on directly from the ISR, so the response time does not depend on the main loop.
  *
  * @date 10 Oct 2024
  */
@@ -12,24 +14,68 @@
 
 #include "../common/std_types.h"
 #define FLAME_PIN GPIO_PD2
+
 /**
- * @brief Initializes the flame sensor pin.
+ * @brief Selects the INT0 driven mode. Comment out to poll the pin from the main loop.
  *
- * This function configures the pin connected to the flame sensor as an input .
- *.
+ * FLAME_PIN must stay on PD2 in this mode because it is the INT0 pin.
+ */
+#define FLAME_SENSOR_INTERRUPT_MODE
+
+#ifndef FLAME_SENSOR_INTERRUPT_MODE
+#define FLAME_SENSOR_POLLING_MODE
+#endif
+
+/**
+ * @brief CPU cycles from the INT0 edge to the first time stamp in the callback.
  *
+ * 4 cycles of interrupt response, 3 for the vector jump, 32 for the prologue of
+ * INT0_vect (it calls through a pointer, so it saves SREG, r0, r1, r18-r27, r30
+ * and r31), 7 to load the callback pointer and icall it. An instruction still
+ * executing when the edge arrives can add up to 4 more, which is not included.
+ */
+#define FLAME_INT0_ENTRY_CYCLES 46
+
+/**
+ * @brief Initializes the flame sensor pin.
  *
+ * This function configures the pin connected to the flame sensor as an input.
+ * In interrupt mode it also enables INT0 on the rising edge; global interrupts
+ * must be enabled by the application.
  */
 void FlameSensor_init(void);
 
 /**
  * @brief Reads the value from the flame sensor.
  *
- * This function reads the current logic level from the sensor pin .
- *
+ * In polling mode this reads the current logic level from the sensor pin.
+ * In interrupt mode it returns the latched alarm; the alarm (and the buzzer) is
+ * released on the first call after the flame is no longer detected.
  *
  * @return The value from the flame sensor (HIGH if flame is detected, LOW if no flame is detected).
  */
 uint8 FlameSensor_getValue(void);
 
+#ifdef FLAME_SENSOR_INTERRUPT_MODE
+/**
+ * @brief Returns the response time of the last alarm in CPU cycles.
+ *
+ * From the INT0 edge to the buzzer pin write: FLAME_INT0_ENTRY_CYCLES for the
+ * interrupt entry, plus the callback up to the write timed with Timer 0 and scaled
+ * by its configured prescaler (one count of resolution). The timed part is only
+ * valid while it is shorter than one Timer 0 period (128 us at prescaler 8).
+ *
+ * @return The last response time in CPU cycles, 0 if no alarm was raised yet or
+ *         Timer 0 was stopped when it was.
+ */
+uint16 FlameSensor_getResponseCycles(void);
+
+/**
+ * @brief Returns the longest response time seen since initialization, in CPU cycles.
+ *
+ * @return The worst response time in CPU cycles.
+ */
+uint16 FlameSensor_getMaxResponseCycles(void);
+#endif
+
 #endif /* FLAME_SENSOR_H_ */
@@ -12,28 +12,377 @@
 
 #include "../mcal/gpio.h"
 #include "lcd.h"
+#ifdef LCD_ASYNC_MODE
+#include "../service/soft_timer.h"
+#include <avr/interrupt.h>
+#endif
 #include <util/delay.h>
 #include <stdlib.h>
+#ifdef LCD_PRINTF
+#include <stdio.h>
+#include <stdarg.h>
+#endif
 #include <avr/io.h>
 
+/**
+ * @brief Marker stored in the display copy for a cell whose contents are unknown.
+ *
+ * 0xFF never matches a printable character, so such cells are resent on the next flush.
+ */
+#define LCD_CELL_UNKNOWN 0xFF
+
+/**
+ * @brief Screen contents requested by the application.
+ */
+static uint8 g_lcdFrame[LCD_ROWS][LCD_COLUMNS];
+
+/**
+ * @brief Screen contents the LCD currently shows.
+ */
+static uint8 g_lcdShown[LCD_ROWS][LCD_COLUMNS];
+
+#ifdef LCD_4_BIT_MODE
+
+/**
+ * @brief Port bits of the LCD_D4..LCD_D7 pins.
+ */
+#define LCD_DATA_MASK ((1 << GPIO_STATIC_BIT(LCD_D4)) | (1 << GPIO_STATIC_BIT(LCD_D5)) \
+        | (1 << GPIO_STATIC_BIT(LCD_D6)) | (1 << GPIO_STATIC_BIT(LCD_D7)))
+
+/**
+ * @brief Port bits that put nibble n on LCD_D4..LCD_D7.
+ */
+#define LCD_NIBBLE_PINS(n) \
+    ((((n) & 1) ? 1 << GPIO_STATIC_BIT(LCD_D4) : 0) | (((n) & 2) ? 1 << GPIO_STATIC_BIT(LCD_D5) : 0) \
+    | (((n) & 4) ? 1 << GPIO_STATIC_BIT(LCD_D6) : 0) | (((n) & 8) ? 1 << GPIO_STATIC_BIT(LCD_D7) : 0))
+
+/**
+ * @brief Port value of every nibble, so a nibble costs one lookup and one masked
+ * write whatever the order of the data pins.
+ */
+static const uint8 g_lcdNibblePins[16] = {
+    LCD_NIBBLE_PINS(0),  LCD_NIBBLE_PINS(1),  LCD_NIBBLE_PINS(2),  LCD_NIBBLE_PINS(3),
+    LCD_NIBBLE_PINS(4),  LCD_NIBBLE_PINS(5),  LCD_NIBBLE_PINS(6),  LCD_NIBBLE_PINS(7),
+    LCD_NIBBLE_PINS(8),  LCD_NIBBLE_PINS(9),  LCD_NIBBLE_PINS(10), LCD_NIBBLE_PINS(11),
+    LCD_NIBBLE_PINS(12), LCD_NIBBLE_PINS(13), LCD_NIBBLE_PINS(14), LCD_NIBBLE_PINS(15)
+};
+
+/**
+ * @brief Puts the low nibble of a value on LCD_D4..LCD_D7 with one masked port write.
+ */
+static void LCD_writeNibble(uint8 a_nibble)
+{
+    GPIO_STATIC_writePortMasked(LCD_D4, LCD_DATA_MASK, g_lcdNibblePins[a_nibble & 0x0F]);
+}
+
+/**
+ * @brief Latches the low nibble of a value with a full E pulse.
+ */
+static void LCD_pulseNibble(uint8 a_nibble)
+{
+    GPIO_STATIC_setPinState(LCD_E, HIGH);
+    _delay_us(LCD_TA_DELAY_US);
+    LCD_writeNibble(a_nibble);
+    _delay_us(LCD_TA_DELAY_US);
+    GPIO_STATIC_setPinState(LCD_E, LOW);
+    _delay_us(LCD_TA_DELAY_US);
+}
+
+#endif /* LCD_4_BIT_MODE */
+
+#ifdef LCD_BUSY_FLAG_MODE
+
+#ifdef LCD_4_BIT_MODE
+/**
+ * @brief Reads the nibble the LCD drives on LCD_D4..LCD_D7 during one E pulse.
+ */
+static uint8 LCD_readNibble(void)
+{
+    uint8 l_pins;
+
+    GPIO_STATIC_setPinState(LCD_E, HIGH);
+    _delay_us(LCD_TA_DELAY_US);         /* Data valid after E rises */
+    l_pins = GPIO_STATIC_PIN_REG(LCD_D4);
+    GPIO_STATIC_setPinState(LCD_E, LOW);
+    _delay_us(LCD_TA_DELAY_US);         /* E low time before the next access */
+    return GET_BIT(l_pins, GPIO_STATIC_BIT(LCD_D4))
+            | (GET_BIT(l_pins, GPIO_STATIC_BIT(LCD_D5)) << 1)
+            | (GET_BIT(l_pins, GPIO_STATIC_BIT(LCD_D6)) << 2)
+            | (GET_BIT(l_pins, GPIO_STATIC_BIT(LCD_D7)) << 3);
+}
+#endif
+
+/**
+ * @brief Reads one byte from the LCD.
+ *
+ * The data pins are switched to input (without pull-ups) for the read and back
+ * to output afterwards. In LCD_4_BIT_MODE the high nibble comes first.
+ *
+ * @param a_rs LOW for the busy flag and address counter, HIGH for DDRAM data.
+ * @return The byte driven by the LCD.
+ */
+static uint8 LCD_readByte(uint8 a_rs)
+{
+    uint8 l_value;
+
+#ifdef LCD_4_BIT_MODE
+    GPIO_STATIC_setPortDirectionMasked(LCD_D4, LCD_DATA_MASK, PORT_INPUT);
+    GPIO_STATIC_writePortMasked(LCD_D4, LCD_DATA_MASK, LOGIC_LOW);
+#else
+    GPIO_setupPortDirection(LCD_DATA_PORT, PORT_INPUT);
+    GPIO_writePort(LCD_DATA_PORT, LOGIC_LOW);
+#endif
+    GPIO_STATIC_setPinState(LCD_RS, a_rs);
+    GPIO_STATIC_setPinState(LCD_RW, HIGH);
+    _delay_us(LCD_TA_DELAY_US);         /* Address setup time */
+#ifdef LCD_4_BIT_MODE
+    l_value = LCD_readNibble() << 4;
+    l_value |= LCD_readNibble();
+#else
+    GPIO_STATIC_setPinState(LCD_E, HIGH);
+    _delay_us(LCD_TA_DELAY_US);         /* Data valid after E rises */
+    l_value = GPIO_readPort(LCD_DATA_PORT);
+    GPIO_STATIC_setPinState(LCD_E, LOW);
+    _delay_us(LCD_TA_DELAY_US);         /* E low time before the next access */
+#endif
+    GPIO_STATIC_setPinState(LCD_RW, LOW);
+#ifdef LCD_4_BIT_MODE
+    GPIO_STATIC_setPortDirectionMasked(LCD_D4, LCD_DATA_MASK, PORT_OUTPUT);
+#else
+    GPIO_setupPortDirection(LCD_DATA_PORT, PORT_OUTPUT);
+#endif
+    return l_value;
+}
+
+/**
+ * @brief Reports whether the LCD is still executing the last byte.
+ */
+static boolean LCD_isBusy(void)
+{
+    return (LCD_readByte(LOW) >> LCD_BUSY_FLAG_BIT) & 1;
+}
+
+#endif /* LCD_BUSY_FLAG_MODE */
+
+#ifdef LCD_ASYNC_MODE
+
+/**
+ * @brief Queue entry flag marking a data byte (RS = 1); entries without it are commands.
+ */
+#define LCD_QUEUE_DATA_FLAG 0x100
+
+/**
+ * @brief Queue entry flag marking a single nibble of the 4-bit initialization.
+ */
+#define LCD_QUEUE_NIBBLE_FLAG 0x200
+
+/**
+ * @brief Software timer ticks covering a wait in microseconds, rounded up.
+ */
+#define LCD_US_TO_TICKS(us) (((us) + SOFT_TIMER_TICK_US - 1) / SOFT_TIMER_TICK_US)
+
+/**
+ * @brief States of the asynchronous writer.
+ */
+typedef enum {
+    LCD_ASYNC_IDLE,   /**< Queue empty, no timer running */
+    LCD_ASYNC_EXECUTE /**< Waiting out the execution time of the last byte */
+} LCD_AsyncState;
+
+/**
+ * @brief Bytes waiting to be written, with LCD_QUEUE_DATA_FLAG set for data.
+ */
+static volatile uint16 g_lcdQueue[LCD_QUEUE_SIZE];
+
+/**
+ * @brief Next queue slot to fill (main context) and next one to send (interrupt).
+ */
+static volatile uint8 g_lcdQueueHead = 0;
+static volatile uint8 g_lcdQueueTail = 0;
+
+static volatile LCD_AsyncState g_lcdAsyncState = LCD_ASYNC_IDLE;
+
+/**
+ * @brief Software timer that paces the writer, one run of bytes per expiry.
+ */
+static SoftTimer g_lcdTimer;
+
+/**
+ * @brief Latches one queue entry: RS, then the byte with a short E pulse (two in
+ * LCD_4_BIT_MODE, one for an initialization nibble).
+ */
+static void LCD_writeEntry(uint16 a_entry)
+{
+    GPIO_STATIC_setPinState(LCD_RS, (a_entry & LCD_QUEUE_DATA_FLAG) ? HIGH : LOW);
+    _delay_us(LCD_TA_DELAY_US);
+#ifdef LCD_4_BIT_MODE
+    if (!(a_entry & LCD_QUEUE_NIBBLE_FLAG))
+        LCD_pulseNibble((uint8) a_entry >> 4);
+    LCD_pulseNibble((uint8) a_entry);
+#else
+    GPIO_writePort(LCD_DATA_PORT, (uint8) a_entry);
+    GPIO_STATIC_setPinState(LCD_E, HIGH);
+    _delay_us(LCD_TA_DELAY_US);
+    GPIO_STATIC_setPinState(LCD_E, LOW);  /* Falling edge latches the byte */
+    _delay_us(LCD_TA_DELAY_US);           /* Hold the data past the edge */
+#endif
+}
+
+/**
+ * @brief Writes a run of queued bytes; runs from the software timer tick.
+ *
+ * Up to LCD_BYTES_PER_TICK bytes go out back to back, each waiting out the one
+ * before it: by the busy flag in LCD_BUSY_FLAG_MODE, otherwise by a
+ * LCD_FAST_COMMAND_US delay. A slow command or an initialization nibble ends the
+ * run, and the timer is restarted for its execution time in whole ticks; after
+ * the last byte of a run the next tick is soon enough. With the queue empty the
+ * writer goes idle.
+ */
+static void LCD_asyncStep(void)
+{
+    uint8 l_budget = LCD_BYTES_PER_TICK;
+    uint16 l_entry;
+    uint16 l_ticks = 1;
+
+#ifdef LCD_BUSY_FLAG_MODE
+    /* A slow command may still run; the busy flag cannot be read until the
+     * interface width is set */
+    if (g_lcdQueueTail != g_lcdQueueHead
+            && !(g_lcdQueue[g_lcdQueueTail] & LCD_QUEUE_NIBBLE_FLAG) && LCD_isBusy())
+    {
+        SoftTimer_start(&g_lcdTimer, LCD_asyncStep, 1, 0);
+        return;
+    }
+#endif
+    if (g_lcdQueueTail == g_lcdQueueHead)
+    {
+        g_lcdAsyncState = LCD_ASYNC_IDLE;
+        return;
+    }
+    for (;;)
+    {
+        l_entry = g_lcdQueue[g_lcdQueueTail];
+        g_lcdQueueTail = (g_lcdQueueTail + 1) & (LCD_QUEUE_SIZE - 1);
+        LCD_writeEntry(l_entry);
+
+#ifdef LCD_4_BIT_MODE
+        if (l_entry & LCD_QUEUE_NIBBLE_FLAG)
+        {
+            l_ticks = LCD_US_TO_TICKS(LCD_INIT_NIBBLE_US);
+            break;
+        }
+#endif
+        if (l_entry == LCD_CLEAR_SCREEN_COMMAND || (l_entry & 0xFE) == LCD_RETURN_HOME_COMMAND)
+        {
+#ifndef LCD_BUSY_FLAG_MODE
+            l_ticks = LCD_US_TO_TICKS(LCD_SLOW_COMMAND_US);
+#endif
+            break;
+        }
+        if (--l_budget == 0 || g_lcdQueueTail == g_lcdQueueHead)
+            break;
+#ifdef LCD_BUSY_FLAG_MODE
+        while (LCD_isBusy())
+            ;
+#else
+        _delay_us(LCD_FAST_COMMAND_US);
+#endif
+    }
+    SoftTimer_start(&g_lcdTimer, LCD_asyncStep, l_ticks, 0);
+}
+
+/**
+ * @brief Lets the writer progress while the caller waits for it.
+ *
+ * With global interrupts disabled (e.g. before sei() at startup) the tick
+ * cannot interrupt, so it is polled instead.
+ */
+static void LCD_serviceWhileWaiting(void)
+{
+    if (!(SREG & (1 << SREG_I)))
+        SoftTimer_poll();
+}
+
+/**
+ * @brief Adds a byte to the write queue and starts the writer if it is idle.
+ *
+ * If the queue is full the caller waits for a free slot.
+ *
+ * @param a_entry The byte, with LCD_QUEUE_DATA_FLAG set for data.
+ */
+static void LCD_enqueue(uint16 a_entry)
+{
+    uint8 l_next = (g_lcdQueueHead + 1) & (LCD_QUEUE_SIZE - 1);
+    uint8 l_sreg;
+
+    while (l_next == g_lcdQueueTail)
+        LCD_serviceWhileWaiting();
+    g_lcdQueue[g_lcdQueueHead] = a_entry;
+
+    l_sreg = SREG;
+    cli();
+    g_lcdQueueHead = l_next;
+    if (g_lcdAsyncState == LCD_ASYNC_IDLE)
+    {
+        g_lcdAsyncState = LCD_ASYNC_EXECUTE;
+        SoftTimer_start(&g_lcdTimer, LCD_asyncStep, 1, 0);
+    }
+    SREG = l_sreg;
+}
+
+#endif /* LCD_ASYNC_MODE */
+
+#ifdef LCD_4_BIT_MODE
+/**
+ * @brief Sends a lone nibble of the 4-bit initialization (RS = 0) and waits
+ * LCD_INIT_NIBBLE_US for it to execute.
+ */
+static void LCD_sendInitNibble(uint8 a_nibble)
+{
+#ifdef LCD_ASYNC_MODE
+    LCD_enqueue(a_nibble | LCD_QUEUE_NIBBLE_FLAG);
+#else
+    GPIO_STATIC_setPinState(LCD_RS, LOW);
+    _delay_us(LCD_TA_DELAY_US);
+    LCD_pulseNibble(a_nibble);
+    _delay_us(LCD_INIT_NIBBLE_US);
+#endif
+}
+#endif
+
 /**
  * @brief Sends a command to the LCD.
  *
  * This function sends a command to the LCD to perform specific operations
  * such as clearing the screen, setting display modes, or moving the cursor.
  *
+ * In LCD_ASYNC_MODE the command is queued and the call returns immediately.
+ *
  * @param a_lcdCommand The command to be sent to the LCD (e.g., LCD_CLEAR_SCREEN_COMMAND).
  */
 void LCD_sendCommand(uint8 a_lcdCommand)
 {
-    GPIO_ARR_setPinState(LCD_RS, LOW);  /* Set RS to 0 for command mode */
+#ifdef LCD_ASYNC_MODE
+    LCD_enqueue(a_lcdCommand);
+#else
+#ifdef LCD_BUSY_FLAG_MODE
+    while (LCD_isBusy())
+        ;                               /* Wait for the previous byte to execute */
+#endif
+    GPIO_STATIC_setPinState(LCD_RS, LOW);  /* Set RS to 0 for command mode */
     _delay_us(LCD_TA_DELAY_US);         /* Delay for timing */
-    GPIO_ARR_setPinState(LCD_E, HIGH);  /* Enable the LCD */
+#ifdef LCD_4_BIT_MODE
+    LCD_pulseNibble(a_lcdCommand >> 4);  /* High nibble first */
+    LCD_pulseNibble(a_lcdCommand);
+#else
+    GPIO_STATIC_setPinState(LCD_E, HIGH);  /* Enable the LCD */
     _delay_us(LCD_TA_DELAY_US);         /* Delay for timing */
     GPIO_writePort(LCD_DATA_PORT, a_lcdCommand);  /* Send command to data port */
     _delay_us(LCD_TA_DELAY_US);         /* Delay for timing */
-    GPIO_ARR_setPinState(LCD_E, LOW);   /* Disable the LCD to latch the command */
+    GPIO_STATIC_setPinState(LCD_E, LOW);   /* Disable the LCD to latch the command */
     _delay_us(LCD_TA_DELAY_US);         /* Delay for timing */
+#endif
+#endif
 }
 
 /**
@@ -42,37 +391,122 @@ void LCD_sendCommand(uint8 a_lcdCommand)
  * This function sends a single character to the LCD for display.
  * It sets the RS pin to 1 to indicate that the data is a character.
  *
+ * In LCD_ASYNC_MODE the character is queued and the call returns immediately.
+ *
  * @param a_lcdChar The ASCII character to be sent to the LCD.
  */
 void LCD_sendChar(uint8 a_lcdChar)
 {
-    GPIO_ARR_setPinState(LCD_RS, HIGH);  /* Set RS to 1 for data mode */
+#ifdef LCD_ASYNC_MODE
+    LCD_enqueue(a_lcdChar | LCD_QUEUE_DATA_FLAG);
+#else
+#ifdef LCD_BUSY_FLAG_MODE
+    while (LCD_isBusy())
+        ;                                /* Wait for the previous byte to execute */
+#endif
+    GPIO_STATIC_setPinState(LCD_RS, HIGH);  /* Set RS to 1 for data mode */
     _delay_us(LCD_TA_DELAY_US);          /* Delay for timing */
-    GPIO_ARR_setPinState(LCD_E, HIGH);   /* Enable the LCD */
+#ifdef LCD_4_BIT_MODE
+    LCD_pulseNibble(a_lcdChar >> 4);     /* High nibble first */
+    LCD_pulseNibble(a_lcdChar);
+#else
+    GPIO_STATIC_setPinState(LCD_E, HIGH);   /* Enable the LCD */
     _delay_us(LCD_TA_DELAY_US);          /* Delay for timing */
     GPIO_writePort(LCD_DATA_PORT, a_lcdChar);  /* Send character to data port */
     _delay_us(LCD_TA_DELAY_US);          /* Delay for timing */
-    GPIO_ARR_setPinState(LCD_E, LOW);    /* Disable the LCD to latch the character */
+    GPIO_STATIC_setPinState(LCD_E, LOW);    /* Disable the LCD to latch the character */
     _delay_us(LCD_TA_DELAY_US);          /* Delay for timing */
+#endif
+#endif
 }
 
 /**
- * @brief Initializes the LCD in 8-bit mode with 2 display lines.
+ * @brief Initializes the LCD in 8-bit or 4-bit mode (LCD_4_BIT_MODE) with 2 display lines.
  *
- * This function configures the LCD by setting the appropriate modes (2-line, 8-bit),
+ * This function configures the LCD by setting the appropriate modes (2-line, 8-bit or 4-bit),
  * turning off the cursor, and clearing the display. It should be called once during initialization.
  */
 void LCD_init()
 {
-    GPIO_ARR_setPinDirection(LCD_RS, PIN_OUTPUT);  /* Set RS pin as output */
-    GPIO_ARR_setPinDirection(LCD_E, PIN_OUTPUT);   /* Set E pin as output */
+    GPIO_STATIC_setPinDirection(LCD_RS, PIN_OUTPUT);  /* Set RS pin as output */
+    GPIO_STATIC_setPinDirection(LCD_E, PIN_OUTPUT);   /* Set E pin as output */
+#ifdef LCD_RW
+    GPIO_STATIC_setPinState(LCD_RW, LOW);             /* Write mode unless reading */
+    GPIO_STATIC_setPinDirection(LCD_RW, PIN_OUTPUT);
+#endif
+#ifdef LCD_4_BIT_MODE
+    GPIO_STATIC_setPortDirectionMasked(LCD_D4, LCD_DATA_MASK, PORT_OUTPUT);  /* Only D4-D7 */
+#else
     GPIO_setupPortDirection(LCD_DATA_PORT, PORT_OUTPUT);  /* Set data port as output */
+#endif
+#ifdef LCD_ASYNC_MODE
+    /*
+     * The power-up wait becomes the first timer run; commands queue up behind it.
+     * The first tick may be nearly over, so one more is added.
+     */
+    GPIO_STATIC_setPinState(LCD_E, LOW);
+    g_lcdAsyncState = LCD_ASYNC_EXECUTE;
+    SoftTimer_start(&g_lcdTimer, LCD_asyncStep, LCD_US_TO_TICKS(LCD_POWER_ON_DELAY_US) + 1, 0);
+#else
     _delay_ms(20);  /* Wait for LCD to power up */
+#endif
 
+#ifdef LCD_4_BIT_MODE
+    LCD_sendInitNibble(LCD_8_BIT_INTERFACE_NIBBLE);  /* Resynchronize in 8-bit mode */
+    LCD_sendInitNibble(LCD_8_BIT_INTERFACE_NIBBLE);
+    LCD_sendInitNibble(LCD_8_BIT_INTERFACE_NIBBLE);
+    LCD_sendInitNibble(LCD_4_BIT_INTERFACE_NIBBLE);  /* Switch to 4-bit mode */
+    LCD_sendCommand(LCD_2_LINE_4_BIT_COMMAND);  /* Set LCD to 2 lines, 4-bit mode */
+#else
     LCD_sendCommand(LCD_2_LINE_8_BIT_COMMAND);  /* Set LCD to 2 lines, 8-bit mode */
+#endif
     LCD_sendCommand(LCD_CURSOR_OFF_COMMAND);    /* Turn off cursor */
     LCD_sendCommand(LCD_CLEAR_SCREEN_COMMAND);  /* Clear the LCD screen */
+
+    /* The display and the framebuffer both start blank */
+    LCD_bufferClear();
+    for (uint8 row = 0; row < LCD_ROWS; row++)
+        for (uint8 col = 0; col < LCD_COLUMNS; col++)
+            g_lcdShown[row][col] = ' ';
+}
+
+/**
+ * @brief Reports whether every queued byte has been written and executed.
+ *
+ * @return TRUE if the LCD is idle, FALSE while bytes are still being sent.
+ */
+boolean LCD_isIdle(void)
+{
+#ifdef LCD_ASYNC_MODE
+    return g_lcdAsyncState == LCD_ASYNC_IDLE;
+#else
+    return TRUE;
+#endif
+}
+
+#ifdef LCD_BUSY_FLAG_MODE
+/**
+ * @brief Reads the character stored in DDRAM at a display position.
+ *
+ * Queued writes are allowed to finish first, so the read sees the display as
+ * the application left it. Reading moves the LCD cursor one cell to the right.
+ *
+ * @param a_lcdRow The row number (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column number (0 to LCD_MAX_COLUMNS_INDEX).
+ * @return The character code at that position.
+ */
+uint8 LCD_readChar(uint8 a_lcdRow, uint8 a_lcdCol)
+{
+    LCD_moveCursor(a_lcdRow, a_lcdCol);
+#ifdef LCD_ASYNC_MODE
+    while (!LCD_isIdle())
+        LCD_serviceWhileWaiting();
+#endif
+    while (LCD_isBusy())
+        ;
+    return LCD_readByte(HIGH);
 }
+#endif
 
 /**
  * @brief Displays a string on the LCD starting from the current cursor position.
@@ -172,3 +606,161 @@ void LCD_clearScreen(void)
 {
     LCD_sendCommand(LCD_CLEAR_SCREEN_COMMAND);  /* Send clear display command */
 }
+
+/**
+ * @brief Fills the framebuffer with spaces.
+ *
+ * Nothing is sent to the LCD until LCD_flush() is called, so a screen can be
+ * cleared and redrawn every loop without flicker or bus traffic.
+ */
+void LCD_bufferClear(void)
+{
+    for (uint8 row = 0; row < LCD_ROWS; row++)
+        for (uint8 col = 0; col < LCD_COLUMNS; col++)
+            g_lcdFrame[row][col] = ' ';
+}
+
+/**
+ * @brief Writes a string into the framebuffer.
+ *
+ * Characters that would fall past the end of the row are dropped instead of
+ * wrapping to the next DDRAM address.
+ *
+ * @param a_lcdRow The row number (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column number (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_lcdString Pointer to the null-terminated string.
+ */
+void LCD_bufferString(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_lcdString)
+{
+    if (a_lcdRow >= LCD_ROWS)
+        return;
+    while (*a_lcdString != '\0' && a_lcdCol < LCD_COLUMNS)
+        g_lcdFrame[a_lcdRow][a_lcdCol++] = *a_lcdString++;
+}
+
+/**
+ * @brief Writes an integer in decimal into the framebuffer.
+ *
+ * Uses the same itoa() conversion as LCD_intgerToString(), so the screen needs
+ * no printf. Digits past the end of the row are dropped.
+ *
+ * @param a_lcdRow The row number (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column number (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_data The integer value to be written.
+ * @return The column after the last digit, where a unit can follow.
+ */
+uint8 LCD_bufferInteger(uint8 a_lcdRow, uint8 a_lcdCol, int a_data)
+{
+    char buff[7];  /* "-32768" and the terminator */
+    uint8 i;
+
+    itoa(a_data, buff, 10);
+    LCD_bufferString(a_lcdRow, a_lcdCol, buff);
+    for (i = 0; buff[i] != '\0'; i++)
+        ;
+    return a_lcdCol + i;
+}
+
+#ifdef LCD_PRINTF
+/**
+ * @brief Formats a field with printf syntax and writes it into the framebuffer.
+ *
+ * The formatted text is limited to one row (LCD_PRINTF_BUFFER_SIZE - 1 characters).
+ * Fixed width conversions such as "%3u" keep fields from leaving stale digits behind.
+ *
+ * @param a_lcdRow The row number (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column number (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_format printf format string, followed by its arguments.
+ */
+void LCD_bufferPrintf(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_format, ...)
+{
+    char buff[LCD_PRINTF_BUFFER_SIZE];
+    va_list args;
+
+    va_start(args, a_format);
+    vsnprintf(buff, sizeof(buff), a_format, args);
+    va_end(args);
+    LCD_bufferString(a_lcdRow, a_lcdCol, buff);
+}
+#endif /* LCD_PRINTF */
+
+/**
+ * @brief Sends the framebuffer cells that differ from the display contents.
+ *
+ * Each run of changed cells costs one cursor command followed by its characters;
+ * the LCD's DDRAM address auto-increment moves the cursor along the run. A single
+ * unchanged cell between two changed ones is resent rather than paying for another
+ * cursor command. Nothing is sent when the screen has not changed.
+ */
+void LCD_flush(void)
+{
+    for (uint8 row = 0; row < LCD_ROWS; row++)
+    {
+        uint8 cursor = LCD_COLUMNS;  /* Column the LCD cursor is at, LCD_COLUMNS if unknown */
+
+        for (uint8 col = 0; col < LCD_COLUMNS; col++)
+        {
+            if (g_lcdFrame[row][col] == g_lcdShown[row][col])
+                continue;
+            if (cursor + 1 == col)
+            {
+                /* One unchanged cell in between: rewriting it is as cheap as a cursor move */
+                LCD_sendChar(g_lcdFrame[row][cursor]);
+                cursor++;
+            }
+            else if (cursor != col)
+            {
+                LCD_moveCursor(row, col);
+            }
+            LCD_sendChar(g_lcdFrame[row][col]);
+            g_lcdShown[row][col] = g_lcdFrame[row][col];
+            cursor = col + 1;
+        }
+    }
+}
+
+/**
+ * @brief Forgets what the display shows, so the next flush redraws every cell.
+ *
+ * Call this after writing to the LCD with the direct functions (LCD_displayString,
+ * LCD_sendChar, ...), which bypass the framebuffer.
+ */
+void LCD_bufferInvalidate(void)
+{
+    for (uint8 row = 0; row < LCD_ROWS; row++)
+        for (uint8 col = 0; col < LCD_COLUMNS; col++)
+            g_lcdShown[row][col] = LCD_CELL_UNKNOWN;
+}
+
+#ifdef LCD_BUSY_FLAG_MODE
+/**
+ * @brief Reads the display back and checks it against what the framebuffer sent.
+ *
+ * Each row is read with one cursor command, using the address auto-increment.
+ * Cells that do not match are marked unknown, so the next LCD_flush() repairs
+ * them. Takes roughly 2 ms for a 16x2 display.
+ *
+ * @return TRUE if every cell matched, FALSE otherwise.
+ */
+boolean LCD_bufferVerify(void)
+{
+    boolean match = TRUE;
+
+    for (uint8 row = 0; row < LCD_ROWS; row++)
+    {
+        for (uint8 col = 0; col < LCD_COLUMNS; col++)
+        {
+            uint8 cell = (col == 0) ? LCD_readChar(row, 0) : LCD_readByte(HIGH);
+
+            if (cell != g_lcdShown[row][col])
+            {
+                g_lcdShown[row][col] = LCD_CELL_UNKNOWN;
+                match = FALSE;
+            }
+            while (LCD_isBusy())
+                ;
+        }
+    }
+    return match;
+}
+#endif
@@ -33,12 +33,56 @@
  */
 #define LCD_E   GPIO_PD1
 
+/**
+ * @brief Optional GPIO pin connected to the Read/Write (RW) pin of the LCD.
+ *
+ * On the board RW is tied to ground and the driver only writes. When RW is wired
+ * to a pin, define LCD_RW to enable LCD_BUSY_FLAG_MODE: before each write the driver
+ * reads the busy flag (DB7) instead of assuming an execution time, so the display
+ * runs at the controller's real speed, and LCD_readChar() can read DDRAM back.
+ */
+/* #define LCD_RW GPIO_PB2 */
+
+#ifdef LCD_RW
+#define LCD_BUSY_FLAG_MODE
+#endif
+
+/**
+ * @brief Bit of the busy flag in the byte read with RS = 0 (the rest is the address counter).
+ */
+#define LCD_BUSY_FLAG_BIT 7
+
+/**
+ * @brief Selects the width of the LCD data bus.
+ *
+ * In LCD_8_BIT_MODE the LCD's D0-D7 take the whole of LCD_DATA_PORT. Define
+ * LCD_4_BIT_MODE to wire only D4-D7, to LCD_D4..LCD_D7: each byte is sent as two
+ * nibbles and each nibble is one masked write of the port, so the other four pins
+ * stay free for other peripherals (e.g. PC0/PC1 for TWI). The four data pins may
+ * be in any order but must be on the same port.
+ */
+/* #define LCD_4_BIT_MODE */
+
+#ifndef LCD_4_BIT_MODE
+#define LCD_8_BIT_MODE
+#endif
+
+#ifdef LCD_8_BIT_MODE
 /**
  * @brief The ID of the GPIO port used for data transmission to the LCD.
  *
  * This should correspond to the microcontroller port where the LCD's data lines (D0-D7) are connected.
  */
 #define LCD_DATA_PORT PORTC_ID
+#else
+/**
+ * @brief GPIO pins connected to the D4-D7 data lines of the LCD in LCD_4_BIT_MODE.
+ */
+#define LCD_D4 GPIO_PC4
+#define LCD_D5 GPIO_PC5
+#define LCD_D6 GPIO_PC6
+#define LCD_D7 GPIO_PC7
+#endif
 
 /**
  * @brief Delay in microseconds for the TA (Enable) signal timing.
@@ -47,11 +91,86 @@
  */
 #define LCD_TA_DELAY_US 1
 
+/**
+ * @brief Selects how bytes are written to the LCD.
+ *
+ * In LCD_ASYNC_MODE, LCD_sendCommand() and LCD_sendChar() only put the byte in a
+ * queue and return. A software timer (see soft_timer.h) sends them in runs of up
+ * to LCD_BYTES_PER_TICK bytes per 1 ms tick, each byte paced by the busy flag in
+ * LCD_BUSY_FLAG_MODE or by LCD_FAST_COMMAND_US otherwise; slower commands end the
+ * run and are waited out in whole ticks. So the main loop never waits for the
+ * display (it only blocks if more than LCD_QUEUE_SIZE - 1 bytes are queued).
+ * SoftTimer_init() must be called before LCD_init(). The tick interrupt
+ * owns the RS and E pins (and the data pins in LCD_4_BIT_MODE), so other outputs
+ * on their ports must not be changed with an interruptible read-modify-write while
+ * the LCD is busy.
+ *
+ * Comment the define out for LCD_BLOCKING_MODE, where every write spins on
+ * LCD_TA_DELAY_US delays and the caller waits for it.
+ */
+#define LCD_ASYNC_MODE
+
+#ifndef LCD_ASYNC_MODE
+#define LCD_BLOCKING_MODE
+#endif
+
+/**
+ * @brief Number of queue entries in LCD_ASYNC_MODE; must be a power of two.
+ *
+ * One entry is kept free to tell a full queue from an empty one. A full redraw
+ * of a 16x2 screen through LCD_flush() takes 34 entries.
+ */
+#define LCD_QUEUE_SIZE 64
+
+/**
+ * @brief Bytes sent back to back in one tick in LCD_ASYNC_MODE.
+ *
+ * The tick interrupt waits out every byte of a run but the last, so this bounds
+ * how long it holds off the other interrupts: about (LCD_BYTES_PER_TICK - 1)
+ * times LCD_FAST_COMMAND_US. A full redraw through LCD_flush() takes 34 bytes.
+ */
+#define LCD_BYTES_PER_TICK 4
+
+/**
+ * @brief Time the HD44780 needs after power-up before it accepts commands.
+ */
+#define LCD_POWER_ON_DELAY_US 20000
+
+/**
+ * @brief Execution time of the clear display and return home commands.
+ */
+#define LCD_SLOW_COMMAND_US 1520
+
+/**
+ * @brief Execution time of every other command and of a data write.
+ */
+#define LCD_FAST_COMMAND_US 37
+
 /**
  * @brief Command to configure the LCD for 2 lines and 8-bit data mode.
  */
 #define LCD_2_LINE_8_BIT_COMMAND 0x38
 
+/**
+ * @brief Command to configure the LCD for 2 lines and 4-bit data mode.
+ */
+#define LCD_2_LINE_4_BIT_COMMAND 0x28
+
+/**
+ * @brief Function set nibbles (upper half of 0x30 and 0x20) of the 4-bit initialization.
+ *
+ * The LCD powers up in 8-bit mode and, after an MCU reset, may even be halfway
+ * through a 4-bit byte. Three 8-bit function sets bring it to a known state, then
+ * a single 4-bit one switches the interface.
+ */
+#define LCD_8_BIT_INTERFACE_NIBBLE 0x03
+#define LCD_4_BIT_INTERFACE_NIBBLE 0x02
+
+/**
+ * @brief Wait after each nibble of the 4-bit initialization (the longest, 4.1 ms, is used for all).
+ */
+#define LCD_INIT_NIBBLE_US 4100
+
 /**
  * @brief Command to turn off the LCD cursor.
  */
@@ -62,6 +181,11 @@
  */
 #define LCD_CLEAR_SCREEN_COMMAND 0x01
 
+/**
+ * @brief Command to move the cursor to the first cell (bit 0 is ignored by the LCD).
+ */
+#define LCD_RETURN_HOME_COMMAND 0x02
+
 /**
  * @brief Number of display rows on the LCD.
  */
@@ -126,7 +250,7 @@ void LCD_sendChar(uint8 data);
 void LCD_sendCommand(uint8 command);
 
 /**
- * @brief Initializes the LCD in 8-bit mode with 2 display lines.
+ * @brief Initializes the LCD in 8-bit or 4-bit mode (LCD_4_BIT_MODE) with 2 display lines.
  *
  * This function should be called during system initialization to configure the LCD.
  */
@@ -165,4 +289,110 @@ typedef enum {
     EXCEEDMAXCOLUMNS /**< Indicates that the operation exceeded the maximum column limit of the LCD. */
 } LCD_ERROR;
 void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str);
+
+/**
+ * @brief Reports whether every queued byte has been written and executed.
+ *
+ * Always TRUE in LCD_BLOCKING_MODE.
+ *
+ * @return TRUE if the LCD is idle, FALSE while bytes are still being sent.
+ */
+boolean LCD_isIdle(void);
+
+#ifdef LCD_BUSY_FLAG_MODE
+/**
+ * @brief Reads the character stored in DDRAM at a display position.
+ *
+ * Waits for queued writes to finish first. Only available when LCD_RW is wired.
+ *
+ * @param a_lcdRow The row number (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column number (0 to LCD_MAX_COLUMNS_INDEX).
+ * @return The character code at that position.
+ */
+uint8 LCD_readChar(uint8 a_lcdRow, uint8 a_lcdCol);
+#endif
+
+/*******************************************************************************
+ *                               Framebuffer                                   *
+ *******************************************************************************/
+
+/*
+ * The framebuffer functions only write to a copy of the display in RAM.
+ * LCD_flush() then sends the cells that differ from what the LCD shows, one
+ * cursor command per run of changed cells, so redrawing an unchanged screen
+ * costs no LCD traffic. The framebuffer assumes it owns the display: after
+ * writing to the LCD directly, call LCD_bufferInvalidate().
+ */
+
+/**
+ * @brief Define LCD_PRINTF to build LCD_bufferPrintf().
+ *
+ * It pulls vsnprintf() from the C library, which costs 1.5 to 2 KB of flash, so
+ * it is left out by default; LCD_bufferInteger() covers the numeric fields.
+ */
+/* #define LCD_PRINTF */
+
+#ifdef LCD_PRINTF
+/**
+ * @brief Size of the temporary string used by LCD_bufferPrintf (one row plus the terminator).
+ */
+#define LCD_PRINTF_BUFFER_SIZE (LCD_COLUMNS + 1)
+#endif
+
+/**
+ * @brief Fills the framebuffer with spaces.
+ */
+void LCD_bufferClear(void);
+
+/**
+ * @brief Writes a string into the framebuffer; text past the end of the row is dropped.
+ *
+ * @param a_lcdRow The row number (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column number (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_lcdString Pointer to the null-terminated string.
+ */
+void LCD_bufferString(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_lcdString);
+
+/**
+ * @brief Writes an integer in decimal into the framebuffer.
+ *
+ * @param a_lcdRow The row number (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column number (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_data The integer value to be written.
+ * @return The column after the last digit, where a unit can follow.
+ */
+uint8 LCD_bufferInteger(uint8 a_lcdRow, uint8 a_lcdCol, int a_data);
+
+#ifdef LCD_PRINTF
+/**
+ * @brief Formats a field with printf syntax and writes it into the framebuffer.
+ *
+ * @param a_lcdRow The row number (0 to LCD_ROWS-1).
+ * @param a_lcdCol The column number (0 to LCD_MAX_COLUMNS_INDEX).
+ * @param a_format printf format string, followed by its arguments.
+ */
+void LCD_bufferPrintf(uint8 a_lcdRow, uint8 a_lcdCol, const char *a_format, ...);
+#endif
+
+/**
+ * @brief Sends the framebuffer cells that differ from the display contents.
+ */
+void LCD_flush(void);
+
+/**
+ * @brief Forgets what the display shows, so the next flush redraws every cell.
+ */
+void LCD_bufferInvalidate(void);
+
+#ifdef LCD_BUSY_FLAG_MODE
+/**
+ * @brief Reads the display back and checks it against what the framebuffer sent.
+ *
+ * Cells that do not match are marked unknown, so the next LCD_flush() repairs them.
+ *
+ * @return TRUE if every cell matched, FALSE otherwise.
+ */
+boolean LCD_bufferVerify(void);
+#endif
+
 #endif /* LCD_H_ */
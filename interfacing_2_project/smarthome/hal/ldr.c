@@ -7,11 +7,38 @@
 #include"../common/std_types.h"
 #include"../common/common_macros.h"
 #include "../mcal/adc.h"
+#include "ldr.h"
+#include "sensor_tables.h"
+#include "../common/filter.h"
+
+/* Median filter over the scan rounds, so one bad conversion cannot flip the LEDs */
+static FILTER_MEDIAN g_ldrFilter;
+static uint8 g_ldrRound;
+static uint16 g_ldrCode;
+
+/*
+ * The percentage needs no more than 8 bits: a 500 kHz ADC clock (26 us per
+ * conversion instead of 104 us) and one result byte. The divider is slow to charge
+ * the sample capacitor in the shorter sample time, so the first conversion after
+ * the multiplexer comes from another channel is thrown away.
+ */
+static const ADC_ChannelProfile g_ldrAdcProfile = { ADC_REFERENCE_INTERNAL,
+		ADC_PRESCALER_32, TRUE, TRUE };
+
+/* Light intensity in percent (0-100) on the logarithmic curve of ldr.h, one flash read */
 uint16 LDR_getLightIntensity(void) {
-	uint16 l_val = ADC_readChannel(0);
-	int l_inten = MAP(((int)l_val), 0, 200, 0, 100);
-	return l_inten;
+	uint8 l_round = ADC_getRoundCount();
+
+	if (l_round != g_ldrRound) {
+		g_ldrRound = l_round;
+		g_ldrCode = Filter_medianUpdate(&g_ldrFilter, ADC_getLatestSample(LDR_CHANNEL_ID));
+	}
+	return pgm_read_byte(&g_ldrPercentTable[g_ldrCode]);
 }
 void LDR_init() {
 	ADC_init();
+	ADC_setChannelProfile(LDR_CHANNEL_ID, &g_ldrAdcProfile);
+	Filter_medianInit(&g_ldrFilter, LDR_FILTER_LENGTH);
+	/* Different from any count, so the first call takes a sample */
+	g_ldrRound = ADC_getRoundCount() - 1;
 }
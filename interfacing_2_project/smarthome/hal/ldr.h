@@ -8,6 +8,22 @@
 #ifndef LDR_H_
 #define LDR_H_
 #include"../common/std_types.h"
+#define LDR_CHANNEL_ID 0
+/* Median window over the scan rounds (3 or 5) */
+#define LDR_FILTER_LENGTH 5
+
+/*
+ * Light curve used by tools/gen_sensor_tables.c. The LDR is the high side of a
+ * divider from LDR_SUPPLY_MV, so the ADC code rises with light. Its resistance
+ * follows a power law of the illuminance, which makes the percentage the log of
+ * the divider ratio: equal steps of % are equal ratios of light, from
+ * LDR_DARK_CODE (0 %) to LDR_BRIGHT_CODE (100 %), clamped outside.
+ * Run `make -C host tables` after changing them.
+ */
+#define LDR_SUPPLY_MV   5000
+#define LDR_DARK_CODE   10
+#define LDR_BRIGHT_CODE 200
+
 uint16 LDR_getLightIntensity(void);
 void LDR_init();
 
@@ -3,25 +3,38 @@
 #include"led.h"
 uint8 LED_pins[] = { GPIO_PB5, GPIO_PB6, GPIO_PB7 };
 void LED_init() {
-	for (int i; i < sizeof(LED_pins); i++) {
+	for (int i = 0; i < sizeof(LED_pins); i++) {
 		GPIO_ARR_setPinDirection(LED_pins[i], PIN_OUTPUT);
 	}
 }
 
-void LED_on(uint8 a_ledid) {
+static void LED_addToBatch(GPIO_Batch *a_batch, uint8 a_ledid, boolean a_on) {
 #ifdef LED_POSTIVE_LOGIC
-	GPIO_ARR_setPinState(LED_pins[a_ledid], LOGIC_HIGH);
+	GPIO_BATCH_setPinState(a_batch, LED_pins[a_ledid], a_on ? HIGH : LOW);
 #else
-	GPIO_ARR_setPinState(LED_pins[a_ledid],LOGIC_LOW);
+	GPIO_BATCH_setPinState(a_batch, LED_pins[a_ledid], a_on ? LOW : HIGH);
 #endif
+}
 
+void LED_on(uint8 a_ledid) {
+	GPIO_Batch l_batch;
+	GPIO_BATCH_init(&l_batch);
+	LED_addToBatch(&l_batch, a_ledid, TRUE);
+	GPIO_BATCH_apply(&l_batch);
 }
 
 void LED_off(uint8 a_ledid) {
-#ifdef LED_POSTIVE_LOGIC
-	GPIO_ARR_setPinState(LED_pins[a_ledid], LOGIC_LOW);
-#else
-	GPIO_ARR_setPinState(LED_pins[a_ledid],LOGIC_HIGH);
-#endif
+	GPIO_Batch l_batch;
+	GPIO_BATCH_init(&l_batch);
+	LED_addToBatch(&l_batch, a_ledid, FALSE);
+	GPIO_BATCH_apply(&l_batch);
+}
 
+void LED_write(uint8 a_ledMask) {
+	GPIO_Batch l_batch;
+	GPIO_BATCH_init(&l_batch);
+	for (uint8 i = 0; i < sizeof(LED_pins); i++) {
+		LED_addToBatch(&l_batch, i, GET_BIT(a_ledMask, i));
+	}
+	GPIO_BATCH_apply(&l_batch);
 }
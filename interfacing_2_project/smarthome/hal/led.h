@@ -11,6 +11,9 @@
 typedef enum {
 	LED_BLUE_1, LED_GREEN_2, LED_RED_3
 } LED_ID;
+
+/* Bit of an LED inside the mask passed to LED_write() */
+#define LED_MASK(id) (1 << (id))
 #define LED_POSTIVE_LOGIC
 
 #ifndef LED_POSTIVE_LOGIC
@@ -19,4 +22,6 @@ typedef enum {
 void LED_init();
 void LED_off(uint8);
 void LED_on(uint8);
+/* Sets every LED at once: bit n of the mask switches LED n on, in a single port write */
+void LED_write(uint8);
 #endif /* LED_H_ */
@@ -11,24 +11,82 @@
  *******************************************************************************/
 
 #include "lm35_sensor.h"
+#include "sensor_tables.h"
 #include "../mcal/adc.h"
+#include "../common/filter.h"
+
+/*
+ * Fixed-point scale of the conversion, per 10-bit code:
+ * tenths = (adc * LM35_TENTHS_SCALE) >> LM35_TENTHS_SHIFT
+ * The scale is worked out by the compiler from the millivolt values, in integer
+ * arithmetic, and rounded up. With 20 fraction bits that gives the truncated
+ * result of the exact formula for every code, and ADC_MAXIMUM_VALUE *
+ * LM35_TENTHS_SCALE still fits in 32 bits. The oversampled reading adds
+ * SENSOR_OVERSAMPLING_BITS below the code; scaling those separately keeps all
+ * 12 bits exact, where one scale over the 12-bit range is not (code 3272 came
+ * out 2047 for an exact 2046.999) and a finer one would overflow 32 bits.
+ */
+#define LM35_TENTHS_SHIFT    20
+#define LM35_TENTHS_SCALE    ((uint32)((((uint64)SENSOR_MAX_TEMPERATURE * 10 * ADC_REF_VOLT_MV) \
+		<< LM35_TENTHS_SHIFT) / ((uint32)ADC_MAXIMUM_VALUE * SENSOR_MAX_VOLT_MV)) + 1)
+#define LM35_FRACTION_MASK   ((1 << SENSOR_OVERSAMPLING_BITS) - 1)
+
+/* Exponential smoothing of the oversampled reading, one update per scan round */
+static FILTER_EMA g_lm35Filter = { 0, SENSOR_FILTER_SHIFT, FALSE };
+static uint8 g_lm35Round;
+static uint16 g_lm35Value;
+
+/*
+ * Description :
+ * Returns the filtered oversampled reading, feeding the filter when the ADC has
+ * finished a new round since the last call.
+ */
+static uint16 LM35_getFilteredSample(void)
+{
+	uint8 l_round = ADC_getRoundCount();
+
+	if (l_round != g_lm35Round || !g_lm35Filter.primed)
+	{
+		g_lm35Round = l_round;
+		g_lm35Value = Filter_emaUpdate(&g_lm35Filter,
+				ADC_getLatestSampleHighRes(SENSOR_CHANNEL_ID, SENSOR_OVERSAMPLING_BITS));
+	}
+	return g_lm35Value;
+}
 
 /*
  * Description :
  * Function responsible for calculate the temperature from the ADC digital value.
+ * Whole degrees Celsius, truncated (saturated at 255), looked up in a flash table.
  */
 uint8 LM35_getTemperature(void)
 {
-	uint8 temp_value = 0;
-
-	uint16 adc_value = 0;
+	/* One flash read, indexed by the filtered sample brought back to 10 bits */
+	return pgm_read_byte(&g_lm35DegreesTable[LM35_getFilteredSample() >> SENSOR_OVERSAMPLING_BITS]);
+}
 
-	/* Read ADC channel where the temperature sensor is connected */
-	adc_value = ADC_readChannel(SENSOR_CHANNEL_ID);
+/*
+ * Description :
+ * Function responsible for calculate the temperature from the ADC digital value
+ * in tenths of a degree Celsius, with integer arithmetic only.
+ */
+uint16 LM35_getTemperatureTenths(void)
+{
+	/* Filtered oversampled reading of the channel where the sensor is connected */
+	return LM35_convertTenths(LM35_getFilteredSample());
+}
 
-	/* Calculate the temperature from the ADC value*/
-	temp_value = (uint8)(((uint32)adc_value*SENSOR_MAX_TEMPERATURE*ADC_REF_VOLT_VALUE)/(ADC_MAXIMUM_VALUE*SENSOR_MAX_VOLT_VALUE));
+/*
+ * Description :
+ * Converts an oversampled reading to tenths of a degree Celsius.
+ */
+uint16 LM35_convertTenths(uint16 a_sample)
+{
+	uint16 l_code = a_sample >> SENSOR_OVERSAMPLING_BITS;
+	uint8 l_fraction = a_sample & LM35_FRACTION_MASK;
 
-	return temp_value;
+	return (uint16)(((uint32)l_code * LM35_TENTHS_SCALE
+			+ (((uint32)l_fraction * LM35_TENTHS_SCALE) >> SENSOR_OVERSAMPLING_BITS))
+			>> LM35_TENTHS_SHIFT);
 }
 
@@ -21,7 +21,12 @@
 
 #define SENSOR_CHANNEL_ID         1
 #define SENSOR_MAX_VOLT_VALUE     1.5
+#define SENSOR_MAX_VOLT_MV        1500
 #define SENSOR_MAX_TEMPERATURE    150
+/* Bits added by oversampling the channel (4^2 = 16 conversions, 12-bit result) */
+#define SENSOR_OVERSAMPLING_BITS  2
+/* Exponential smoothing over about 2^3 = 8 scan rounds (see common/filter.h) */
+#define SENSOR_FILTER_SHIFT       3
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
@@ -30,7 +35,24 @@
 /*
  * Description :
  * Function responsible for calculate the temperature from the ADC digital value.
+ * Whole degrees Celsius, truncated (saturated at 255), looked up in a flash table.
  */
 uint8 LM35_getTemperature(void);
 
+/*
+ * Description :
+ * Function responsible for calculate the temperature from the ADC digital value
+ * in tenths of a degree Celsius (e.g. 253 for 25.3 C), with integer arithmetic only.
+ * Uses the oversampled reading, so the step is about 0.06 C instead of 0.25 C.
+ */
+uint16 LM35_getTemperatureTenths(void);
+
+/*
+ * Description :
+ * Converts an oversampled reading (ADC code << SENSOR_OVERSAMPLING_BITS) to tenths
+ * of a degree Celsius. This is the arithmetic behind LM35_getTemperatureTenths(),
+ * without the ADC, so the host tests can check every code.
+ */
+uint16 LM35_convertTenths(uint16 a_sample);
+
 #endif /* LM35_SENSOR_H_ */
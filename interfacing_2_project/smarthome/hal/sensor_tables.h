@@ -0,0 +1,36 @@
+/**
+ * @file sensor_tables.h
+ * @brief Flash tables converting raw ADC codes to sensor readings.
+ *
+ * The tables are indexed directly by the 10-bit ADC code, so a conversion is one
+ * flash read with no arithmetic. They are generated by tools/gen_sensor_tables.c
+ * from the sensor constants in lm35_sensor.h, ldr.h and adc.h; run
+ * `make -C host tables` after changing any of them.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SENSOR_TABLES_H_
+#define SENSOR_TABLES_H_
+
+#include "../common/std_types.h"
+#include "../mcal/adc.h"
+#include <avr/pgmspace.h>
+
+/**
+ * @brief Number of entries in each table, one per ADC code.
+ */
+#define SENSOR_TABLE_SIZE (ADC_MAXIMUM_VALUE + 1)
+
+/**
+ * @brief LM35 temperature in whole degrees Celsius (truncated, saturated at 255).
+ */
+extern const uint8 g_lm35DegreesTable[SENSOR_TABLE_SIZE] PROGMEM;
+
+/**
+ * @brief LDR light intensity in percent (0-100) on the logarithmic curve of ldr.h.
+ */
+extern const uint8 g_ldrPercentTable[SENSOR_TABLE_SIZE] PROGMEM;
+
+#endif /* SENSOR_TABLES_H_ */
@@ -0,0 +1,25 @@
+/**
+ * @file interrupt.h
+ * @brief Host build replacement for <avr/interrupt.h>.
+ *
+ * `ISR(vector)` defines a plain function named after the vector (see io.h) that the
+ * simulator calls when the interrupt is enabled and pending. `sei()` and `cli()` change
+ * the I bit of the simulated SREG.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+void SIM_sei(void);
+void SIM_cli(void);
+
+#define ISR(vector, ...) void vector(void)
+#define sei() SIM_sei()
+#define cli() SIM_cli()
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
@@ -0,0 +1,127 @@
+/**
+ * @file io.h
+ * @brief Host build replacement for <avr/io.h> (ATmega32 only).
+ *
+ * Every I/O register is a byte of the simulator's register file, at the same data
+ * memory address as on the real chip, so `PORTB`, `PINA` and the `*_REG` unions of
+ * atmega32_regs.h all see the same storage. Plain accesses through these names do
+ * not advance the simulated clock; the simulator samples them on the next access
+ * through atmega32_regs.h, `_delay_us()`/`_delay_ms()`, `cli()`/`sei()` or a sleep.
+ * SREG is the exception: it is read and written through the simulator so loops
+ * that only poll RAM and the interrupt flag still let time pass.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+#include <stdint.h>
+
+extern volatile uint8_t SIM_ioMemory[];
+extern volatile uint8_t *SIM_accessRegister(uint8_t a_address);
+
+#define _SFR_MEM8(address)  (SIM_ioMemory[address])
+#define _SFR_MEM16(address) (*(volatile uint16_t *) &SIM_ioMemory[address])
+#define _SFR_IO8(address)   _SFR_MEM8((address) + 0x20)
+#define _SFR_IO16(address)  _SFR_MEM16((address) + 0x20)
+#define _BV(bit)            (1 << (bit))
+
+/* Ports */
+#define PINA   _SFR_IO8(0x19)
+#define DDRA   _SFR_IO8(0x1A)
+#define PORTA  _SFR_IO8(0x1B)
+#define PINB   _SFR_IO8(0x16)
+#define DDRB   _SFR_IO8(0x17)
+#define PORTB  _SFR_IO8(0x18)
+#define PINC   _SFR_IO8(0x13)
+#define DDRC   _SFR_IO8(0x14)
+#define PORTC  _SFR_IO8(0x15)
+#define PIND   _SFR_IO8(0x10)
+#define DDRD   _SFR_IO8(0x11)
+#define PORTD  _SFR_IO8(0x12)
+
+/* ADC */
+#define ADCW   _SFR_IO16(0x04)
+#define ADC    _SFR_IO16(0x04)
+#define ADCL   _SFR_IO8(0x04)
+#define ADCH   _SFR_IO8(0x05)
+#define ADCSRA _SFR_IO8(0x06)
+#define ADMUX  _SFR_IO8(0x07)
+
+/* Timers */
+#define ICR1   _SFR_IO16(0x26)
+#define OCR1B  _SFR_IO16(0x28)
+#define OCR1A  _SFR_IO16(0x2A)
+#define TCNT1  _SFR_IO16(0x2C)
+#define TCCR1B _SFR_IO8(0x2E)
+#define TCCR1A _SFR_IO8(0x2F)
+#define OCR2   _SFR_IO8(0x23)
+#define TCNT2  _SFR_IO8(0x24)
+#define TCCR2  _SFR_IO8(0x25)
+#define ASSR   _SFR_IO8(0x22)
+#define TCNT0  _SFR_IO8(0x32)
+#define TCCR0  _SFR_IO8(0x33)
+#define OCR0   _SFR_IO8(0x3C)
+#define TIFR   _SFR_IO8(0x38)
+#define TIMSK  _SFR_IO8(0x39)
+
+/* System */
+#define SFIOR  _SFR_IO8(0x30)
+#define MCUCSR _SFR_IO8(0x34)
+#define MCUCR  _SFR_IO8(0x35)
+#define GIFR   _SFR_IO8(0x3A)
+#define GICR   _SFR_IO8(0x3B)
+#define SREG   (*SIM_accessRegister(0x3F + 0x20))
+
+/* SREG bits */
+#define SREG_I 7
+
+/* Port bit numbers */
+#define PA0 0
+#define PA1 1
+#define PA2 2
+#define PA3 3
+#define PA4 4
+#define PA5 5
+#define PA6 6
+#define PA7 7
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PC7 7
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+/* Interrupt vectors, implemented as plain functions the simulator calls */
+#define INT0_vect         SIM_vector_INT0
+#define TIMER2_COMP_vect  SIM_vector_TIMER2_COMP
+#define TIMER2_OVF_vect   SIM_vector_TIMER2_OVF
+#define TIMER1_CAPT_vect  SIM_vector_TIMER1_CAPT
+#define TIMER1_COMPA_vect SIM_vector_TIMER1_COMPA
+#define TIMER1_COMPB_vect SIM_vector_TIMER1_COMPB
+#define TIMER1_OVF_vect   SIM_vector_TIMER1_OVF
+#define TIMER0_COMP_vect  SIM_vector_TIMER0_COMP
+#define TIMER0_OVF_vect   SIM_vector_TIMER0_OVF
+#define ADC_vect          SIM_vector_ADC
+
+#endif /* HOST_AVR_IO_H_ */
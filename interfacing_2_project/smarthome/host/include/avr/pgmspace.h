@@ -0,0 +1,29 @@
+/**
+ * @file pgmspace.h
+ * @brief Host build replacement for <avr/pgmspace.h>.
+ *
+ * The host has a single address space, so program memory data is ordinary
+ * read-only data and the `pgm_read_*` helpers are plain dereferences.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+
+#define pgm_read_byte(address)  (*(const uint8_t *) (address))
+#define pgm_read_word(address)  (*(const uint16_t *) (address))
+#define pgm_read_dword(address) (*(const uint32_t *) (address))
+#define pgm_read_ptr(address)   (*(void * const *) (address))
+
+#define memcpy_P(dest, src, n) memcpy((dest), (src), (n))
+#define strlen_P(s)            strlen(s)
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
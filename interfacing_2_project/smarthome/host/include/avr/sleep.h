@@ -0,0 +1,20 @@
+/**
+ * @file sleep.h
+ * @brief Host build replacement for <avr/sleep.h>.
+ *
+ * `sleep_cpu()` executes the SLEEP instruction in the simulator: with SE set in
+ * MCUCR the CPU stops in the mode selected by SM2:0 until an interrupt wakes it.
+ * The mode and enable bits are set by the firmware through MCUCR as on the chip.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef HOST_AVR_SLEEP_H_
+#define HOST_AVR_SLEEP_H_
+
+void SIM_sleep(void);
+
+#define sleep_cpu() SIM_sleep()
+
+#endif /* HOST_AVR_SLEEP_H_ */
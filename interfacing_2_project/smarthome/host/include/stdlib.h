@@ -0,0 +1,16 @@
+/**
+ * @file stdlib.h
+ * @brief Host build wrapper adding the avr-libc extensions missing from glibc.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef HOST_STDLIB_H_
+#define HOST_STDLIB_H_
+
+#include_next <stdlib.h>
+
+char *itoa(int a_value, char *a_buffer, int a_radix);
+
+#endif /* HOST_STDLIB_H_ */
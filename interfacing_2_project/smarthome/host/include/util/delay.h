@@ -0,0 +1,31 @@
+/**
+ * @file delay.h
+ * @brief Host build replacement for <util/delay.h>.
+ *
+ * Busy-wait delays advance the simulated clock by the same number of CPU cycles
+ * they would burn on the ATmega32. Pending interrupts are serviced during the delay.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#error "F_CPU must be defined for the host build"
+#endif
+
+void SIM_delayCycles(uint32_t a_cycles);
+
+static inline void _delay_us(double a_us) {
+    SIM_delayCycles((uint32_t) (a_us * ((double) F_CPU / 1000000.0)));
+}
+
+static inline void _delay_ms(double a_ms) {
+    SIM_delayCycles((uint32_t) (a_ms * ((double) F_CPU / 1000.0)));
+}
+
+#endif /* HOST_UTIL_DELAY_H_ */
@@ -0,0 +1,166 @@
+/**
+ * @file sim.h
+ * @brief Simulated ATmega32 used by the host build.
+ *
+ * The simulator owns the I/O register file, the cycle counter and the interrupt
+ * controller, and runs peripheral models (timers, ADC, external interrupt, pins and
+ * an HD44780 LCD wired like the board), with models of the room and the fan. Inputs are driven by a scenario file whose
+ * path is read from the `SIM_SCENARIO` environment variable.
+ *
+ * Time only moves when the firmware touches a register through atmega32_regs.h,
+ * calls a delay, `cli()`/`sei()`, or sleeps; plain C code is treated as free.
+ * As on the AVR, the instruction after `sei()` runs before any pending interrupt,
+ * so `sei(); sleep_cpu();` cannot miss its wake-up. The
+ * cycle counts are therefore a lower bound, but they are exact and repeatable for
+ * the register, delay and interrupt traffic, which is what dominates this firmware.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Size of the data memory area holding the I/O registers (0x00-0x5F).
+ */
+#define SIM_IO_MEMORY_SIZE 0x60
+
+/**
+ * @brief CPU cycles charged for one register access through atmega32_regs.h.
+ */
+#define SIM_REGISTER_ACCESS_CYCLES 2
+
+/**
+ * @brief CPU cycles charged for entering and leaving an interrupt service routine.
+ */
+#define SIM_ISR_OVERHEAD_CYCLES 10
+
+/**
+ * @brief CPU cycles the core stays halted after an interrupt wakes it from sleep.
+ */
+#define SIM_WAKE_UP_CYCLES 4
+
+/**
+ * @brief Sleep modes (SM2:0 in MCUCR) the simulator models.
+ *
+ * In ADC Noise Reduction mode the I/O clock stops: the timers halt and INT0 only
+ * wakes the chip on a low level.
+ */
+#define SIM_SLEEP_IDLE                0
+#define SIM_SLEEP_ADC_NOISE_REDUCTION 1
+#define SIM_SLEEP_MODES               2
+#define SIM_AWAKE                     0xFF
+
+/**
+ * @brief Number of ADC input channels.
+ */
+#define SIM_ADC_CHANNELS 8
+
+/**
+ * @brief Interrupt sources, in ATmega32 vector priority order.
+ */
+typedef enum {
+    SIM_IRQ_INT0,
+    SIM_IRQ_TIMER2_COMP,
+    SIM_IRQ_TIMER2_OVF,
+    SIM_IRQ_TIMER1_CAPT,
+    SIM_IRQ_TIMER1_COMPA,
+    SIM_IRQ_TIMER1_COMPB,
+    SIM_IRQ_TIMER1_OVF,
+    SIM_IRQ_TIMER0_COMP,
+    SIM_IRQ_TIMER0_OVF,
+    SIM_IRQ_ADC,
+    SIM_IRQ_COUNT
+} SIM_Irq;
+
+/*******************************************************************************
+ *                                Global Variables                             *
+ *******************************************************************************/
+
+/**
+ * @brief The simulated register file, indexed by data memory address.
+ */
+extern volatile uint8_t SIM_ioMemory[SIM_IO_MEMORY_SIZE];
+
+/*******************************************************************************
+ *                                Functions Prototypes                         *
+ *******************************************************************************/
+
+/* Called from the firmware side (register macros, shims) */
+volatile uint8_t *SIM_accessRegister(uint8_t a_address);
+const volatile uint8_t *SIM_readFlags(uint8_t a_address);
+void SIM_delayCycles(uint32_t a_cycles);
+void SIM_sei(void);
+void SIM_cli(void);
+void SIM_sleep(void);
+
+/* Clock */
+uint64_t SIM_getCycles(void);
+void SIM_advance(uint32_t a_cycles);
+double SIM_getTimeMs(void);
+
+/* Interrupt controller and sleep */
+uint8_t SIM_interruptsEnabled(void);
+uint8_t SIM_getSleepMode(void);
+
+/* Peripheral models (sim_peripherals.c) */
+void SIM_peripheralsReset(void);
+void SIM_peripheralsSample(void);
+void SIM_peripheralsTick(void);
+void SIM_peripheralsAccess(uint8_t a_address);
+void SIM_peripheralsSleep(uint8_t a_mode);
+int SIM_peripheralsPendingIrq(void);
+void SIM_peripheralsAcknowledgeIrq(SIM_Irq a_irq);
+void SIM_setPinInput(uint8_t a_port, uint8_t a_bit, uint8_t a_level);
+void SIM_releasePinInput(uint8_t a_port, uint8_t a_bit);
+void SIM_setAdcInput(uint8_t a_channel, double a_code);
+void SIM_setAdcNoise(uint8_t a_channel, double a_rms);
+void SIM_setAdcCpuNoise(double a_rms);
+void SIM_setAdcPwmNoise(double a_rms, double a_us);
+void SIM_printSnapshot(void);
+void SIM_printPeripheralStats(void);
+double SIM_getFanDuty(void);
+
+/* Thermal model of the room (sim_plant.c) */
+void SIM_plantStart(uint8_t a_channel, double a_ambient);
+void SIM_plantSetHeat(double a_rise);
+void SIM_plantUpdate(void);
+int SIM_plantTemperature(double *a_temperature);
+void SIM_printPlantStats(void);
+
+/* Fan rotor and tachometer (sim_fan.c) */
+void SIM_fanStart(double a_maxRpm, uint8_t a_pulses);
+void SIM_fanSetLoad(double a_load);
+void SIM_fanSetSpikes(uint32_t a_cycles);
+void SIM_fanTick(void);
+int SIM_fanRpm(double *a_rpm);
+void SIM_printFanStats(void);
+
+/* Scenario (sim_scenario.c) */
+void SIM_scenarioLoad(const char *a_path);
+void SIM_scenarioPoll(void);
+uint64_t SIM_scenarioNextEventCycle(void);
+
+/* Run control */
+void SIM_finish(void);
+
+/* Interrupt vectors; weak empty versions are replaced by the firmware's ISR() */
+void SIM_vector_INT0(void);
+void SIM_vector_TIMER2_COMP(void);
+void SIM_vector_TIMER2_OVF(void);
+void SIM_vector_TIMER1_CAPT(void);
+void SIM_vector_TIMER1_COMPA(void);
+void SIM_vector_TIMER1_COMPB(void);
+void SIM_vector_TIMER1_OVF(void);
+void SIM_vector_TIMER0_COMP(void);
+void SIM_vector_TIMER0_OVF(void);
+void SIM_vector_ADC(void);
+
+#endif /* SIM_H_ */
@@ -0,0 +1,331 @@
+/**
+ * @file sim_core.c
+ * @brief Register file, clock and interrupt controller of the simulated ATmega32.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Data memory address of SREG and position of its global interrupt bit.
+ */
+#define SIM_SREG_ADDRESS 0x5F
+#define SIM_SREG_I_BIT   7
+
+/**
+ * @brief Data memory address of MCUCR, its sleep enable bit and sleep mode field.
+ */
+#define SIM_MCUCR_ADDRESS 0x55
+#define SIM_MCUCR_SE_BIT  7
+#define SIM_MCUCR_SM_SHIFT 4
+#define SIM_MCUCR_SM_MASK 0x07
+
+volatile uint8_t SIM_ioMemory[SIM_IO_MEMORY_SIZE];
+
+static uint64_t g_cycles = 0;
+static uint64_t g_delayCycles = 0;
+static uint64_t g_isrCycles = 0;
+static uint32_t g_irqCount[SIM_IRQ_COUNT];
+static uint8_t g_inIsr = 0;
+/* Set by sei(): the next instruction runs before any pending interrupt */
+static uint8_t g_interruptShadow = 0;
+static uint8_t g_sleepMode = SIM_AWAKE;
+static uint64_t g_sleepCycles[SIM_SLEEP_MODES];
+static uint32_t g_wakeUps = 0;
+
+/* Default (empty) vectors, replaced by the firmware's ISR() definitions */
+#define SIM_WEAK_VECTOR(name) __attribute__((weak)) void name(void) {}
+SIM_WEAK_VECTOR(SIM_vector_INT0)
+SIM_WEAK_VECTOR(SIM_vector_TIMER2_COMP)
+SIM_WEAK_VECTOR(SIM_vector_TIMER2_OVF)
+SIM_WEAK_VECTOR(SIM_vector_TIMER1_CAPT)
+SIM_WEAK_VECTOR(SIM_vector_TIMER1_COMPA)
+SIM_WEAK_VECTOR(SIM_vector_TIMER1_COMPB)
+SIM_WEAK_VECTOR(SIM_vector_TIMER1_OVF)
+SIM_WEAK_VECTOR(SIM_vector_TIMER0_COMP)
+SIM_WEAK_VECTOR(SIM_vector_TIMER0_OVF)
+SIM_WEAK_VECTOR(SIM_vector_ADC)
+
+static void (*const g_vectors[SIM_IRQ_COUNT])(void) = {
+    SIM_vector_INT0,
+    SIM_vector_TIMER2_COMP,
+    SIM_vector_TIMER2_OVF,
+    SIM_vector_TIMER1_CAPT,
+    SIM_vector_TIMER1_COMPA,
+    SIM_vector_TIMER1_COMPB,
+    SIM_vector_TIMER1_OVF,
+    SIM_vector_TIMER0_COMP,
+    SIM_vector_TIMER0_OVF,
+    SIM_vector_ADC
+};
+
+static const char *const g_irqNames[SIM_IRQ_COUNT] = {
+    "INT0", "TIMER2_COMP", "TIMER2_OVF", "TIMER1_CAPT", "TIMER1_COMPA",
+    "TIMER1_COMPB", "TIMER1_OVF", "TIMER0_COMP", "TIMER0_OVF", "ADC"
+};
+
+/**
+ * @brief Runs the highest priority pending interrupt until none is left.
+ *
+ * Interrupts do not nest: the I bit is cleared while a vector runs, as on the AVR.
+ */
+static void SIM_dispatchInterrupts(void) {
+    int l_irq;
+
+    while (!g_inIsr && !g_interruptShadow && (SIM_ioMemory[SIM_SREG_ADDRESS] & (1 << SIM_SREG_I_BIT))
+            && (l_irq = SIM_peripheralsPendingIrq()) >= 0) {
+        uint64_t l_start = g_cycles;
+
+        SIM_peripheralsAcknowledgeIrq((SIM_Irq) l_irq);
+        g_irqCount[l_irq]++;
+        g_inIsr = 1;
+        SIM_ioMemory[SIM_SREG_ADDRESS] &= ~(1 << SIM_SREG_I_BIT);
+        SIM_advance(SIM_ISR_OVERHEAD_CYCLES);
+        g_vectors[l_irq]();
+        SIM_peripheralsSample();
+        SIM_ioMemory[SIM_SREG_ADDRESS] |= (1 << SIM_SREG_I_BIT);
+        g_inIsr = 0;
+        g_isrCycles += g_cycles - l_start;
+    }
+}
+
+/**
+ * @brief Advances the clock by one cycle: scenario events and clocked peripherals.
+ */
+static void SIM_step(void) {
+    g_cycles++;
+    if (g_cycles >= SIM_scenarioNextEventCycle()) {
+        SIM_scenarioPoll();
+        SIM_peripheralsSample();
+    }
+    SIM_peripheralsTick();
+}
+
+/**
+ * @brief Advances the simulated clock, running peripherals and interrupts.
+ *
+ * @param a_cycles Number of CPU cycles to advance.
+ */
+void SIM_advance(uint32_t a_cycles) {
+    SIM_peripheralsSample();
+    SIM_dispatchInterrupts();
+    while (a_cycles--) {
+        SIM_step();
+        SIM_dispatchInterrupts();
+    }
+}
+
+/**
+ * @brief Hook behind every atmega32_regs.h register access.
+ *
+ * @param a_address Data memory address of the register.
+ * @return Pointer to the register inside the simulated register file.
+ */
+volatile uint8_t *SIM_accessRegister(uint8_t a_address) {
+    g_interruptShadow = 0;
+    SIM_advance(SIM_REGISTER_ACCESS_CYCLES);
+    SIM_peripheralsAccess(a_address);
+    return &SIM_ioMemory[a_address];
+}
+
+/**
+ * @brief Hook behind the read-only flag register macros of atmega32_regs.h.
+ *
+ * Like SIM_accessRegister(), but the access is not reported to the peripherals,
+ * so reading a flag register does not clear the flags it returns.
+ *
+ * @param a_address Data memory address of the register.
+ * @return Pointer to the register inside the simulated register file.
+ */
+const volatile uint8_t *SIM_readFlags(uint8_t a_address) {
+    g_interruptShadow = 0;
+    SIM_advance(SIM_REGISTER_ACCESS_CYCLES);
+    return &SIM_ioMemory[a_address];
+}
+
+/**
+ * @brief Busy-waits for the given number of CPU cycles.
+ *
+ * @param a_cycles Number of CPU cycles.
+ */
+void SIM_delayCycles(uint32_t a_cycles) {
+    g_interruptShadow = 0;
+    g_delayCycles += a_cycles;
+    SIM_advance(a_cycles);
+}
+
+/**
+ * @brief Sets the global interrupt enable bit.
+ *
+ * Pending interrupts wait for the next instruction (register access, delay,
+ * cli(), sleep) to start, as after SEI on the AVR.
+ */
+void SIM_sei(void) {
+    SIM_ioMemory[SIM_SREG_ADDRESS] |= (1 << SIM_SREG_I_BIT);
+    g_interruptShadow = 1;
+    SIM_advance(1);
+}
+
+/**
+ * @brief Clears the global interrupt enable bit.
+ */
+void SIM_cli(void) {
+    g_interruptShadow = 0;
+    SIM_ioMemory[SIM_SREG_ADDRESS] &= ~(1 << SIM_SREG_I_BIT);
+    SIM_advance(1);
+}
+
+/**
+ * @brief Executes SLEEP: halts the core until an enabled interrupt is pending.
+ *
+ * Without SE in MCUCR the instruction does nothing. Otherwise the peripherals
+ * keep running (the timers only in Idle mode) and the cycles are counted per
+ * mode. On waking the core stays halted SIM_WAKE_UP_CYCLES more and then runs
+ * the interrupt if the I bit is set, as on the AVR.
+ */
+void SIM_sleep(void) {
+    uint8_t l_mcucr = SIM_ioMemory[SIM_MCUCR_ADDRESS];
+    uint8_t l_mode = (l_mcucr >> SIM_MCUCR_SM_SHIFT) & SIM_MCUCR_SM_MASK;
+    uint64_t l_start;
+
+    g_interruptShadow = 0;
+    if (!(l_mcucr & (1 << SIM_MCUCR_SE_BIT))) {
+        SIM_advance(1);
+        return;
+    }
+    if (l_mode >= SIM_SLEEP_MODES) {
+        fprintf(stderr, "sim: sleep mode %u is not modelled\n", l_mode);
+        exit(2);
+    }
+
+    SIM_peripheralsSample();
+    g_sleepMode = l_mode;
+    SIM_peripheralsSleep(l_mode);
+    l_start = g_cycles;
+    while (SIM_peripheralsPendingIrq() < 0) {
+        SIM_step();
+    }
+    g_sleepCycles[l_mode] += g_cycles - l_start;
+    g_wakeUps++;
+    g_sleepMode = SIM_AWAKE;
+    SIM_advance(SIM_WAKE_UP_CYCLES);
+}
+
+/**
+ * @brief Returns the sleep mode the core is in, or SIM_AWAKE.
+ */
+uint8_t SIM_getSleepMode(void) {
+    return g_sleepMode;
+}
+
+/**
+ * @brief Returns non-zero when the global interrupt enable bit is set.
+ */
+uint8_t SIM_interruptsEnabled(void) {
+    return (SIM_ioMemory[SIM_SREG_ADDRESS] >> SIM_SREG_I_BIT) & 1;
+}
+
+/**
+ * @brief Returns the number of CPU cycles simulated so far.
+ */
+uint64_t SIM_getCycles(void) {
+    return g_cycles;
+}
+
+/**
+ * @brief Returns the simulated time in milliseconds.
+ */
+double SIM_getTimeMs(void) {
+    return (double) g_cycles * 1000.0 / (double) F_CPU;
+}
+
+/**
+ * @brief Prints the run summary and ends the program.
+ */
+void SIM_finish(void) {
+    int i;
+
+    printf("---- summary ----\n");
+    printf("simulated time : %.3f ms (%llu cycles)\n", SIM_getTimeMs(),
+            (unsigned long long) g_cycles);
+    printf("busy-wait      : %llu cycles (%.1f %%)\n",
+            (unsigned long long) g_delayCycles,
+            g_cycles ? 100.0 * (double) g_delayCycles / (double) g_cycles : 0.0);
+    printf("in ISRs        : %llu cycles (%.1f %%)\n",
+            (unsigned long long) g_isrCycles,
+            g_cycles ? 100.0 * (double) g_isrCycles / (double) g_cycles : 0.0);
+    if (g_wakeUps) {
+        uint64_t l_asleep = g_sleepCycles[SIM_SLEEP_IDLE]
+                + g_sleepCycles[SIM_SLEEP_ADC_NOISE_REDUCTION];
+
+        printf("active         : %llu cycles (%.1f %%)\n",
+                (unsigned long long) (g_cycles - l_asleep),
+                100.0 * (double) (g_cycles - l_asleep) / (double) g_cycles);
+        printf("sleep idle     : %llu cycles (%.1f %%)\n",
+                (unsigned long long) g_sleepCycles[SIM_SLEEP_IDLE],
+                100.0 * (double) g_sleepCycles[SIM_SLEEP_IDLE] / (double) g_cycles);
+        printf("sleep adc nr   : %llu cycles (%.1f %%)\n",
+                (unsigned long long) g_sleepCycles[SIM_SLEEP_ADC_NOISE_REDUCTION],
+                100.0 * (double) g_sleepCycles[SIM_SLEEP_ADC_NOISE_REDUCTION]
+                        / (double) g_cycles);
+        printf("wake-ups       : %u\n", g_wakeUps);
+    }
+    for (i = 0; i < SIM_IRQ_COUNT; i++) {
+        if (g_irqCount[i]) {
+            printf("irq %-12s: %u\n", g_irqNames[i], g_irqCount[i]);
+        }
+    }
+    SIM_printPeripheralStats();
+    SIM_printSnapshot();
+    fflush(stdout);
+    exit(0);
+}
+
+/**
+ * @brief avr-libc itoa(), missing from glibc.
+ */
+char *itoa(int a_value, char *a_buffer, int a_radix) {
+    char l_digits[8 * sizeof(int) + 1];
+    unsigned int l_magnitude;
+    int l_length = 0;
+    int l_pos = 0;
+
+    if (a_radix < 2 || a_radix > 36) {
+        a_buffer[0] = '\0';
+        return a_buffer;
+    }
+    l_magnitude = (a_value < 0 && a_radix == 10) ? -(unsigned int) a_value
+            : (unsigned int) a_value;
+    do {
+        unsigned int l_digit = l_magnitude % a_radix;
+        l_digits[l_length++] = (char) (l_digit < 10 ? '0' + l_digit : 'a' + l_digit - 10);
+        l_magnitude /= a_radix;
+    } while (l_magnitude);
+    if (a_value < 0 && a_radix == 10) {
+        a_buffer[l_pos++] = '-';
+    }
+    while (l_length) {
+        a_buffer[l_pos++] = l_digits[--l_length];
+    }
+    a_buffer[l_pos] = '\0';
+    return a_buffer;
+}
+
+/**
+ * @brief Resets the simulated chip and loads the scenario before main() runs.
+ */
+__attribute__((constructor)) static void SIM_powerOn(void) {
+    const char *l_scenario = getenv("SIM_SCENARIO");
+
+    SIM_peripheralsReset();
+    if (l_scenario != NULL) {
+        SIM_scenarioLoad(l_scenario);
+    } else {
+        fprintf(stderr, "SIM_SCENARIO not set, running with idle inputs\n");
+        SIM_scenarioLoad(NULL);
+    }
+}
@@ -0,0 +1,191 @@
+/**
+ * @file sim_fan.c
+ * @brief Rotor model of the fan and its tachometer output on ICP1 (PD6).
+ *
+ * The rotor speed follows the drive with a first-order lag:
+ *
+ *     d(rpm)/dt = (max_rpm * duty * load - rpm) / tau
+ *
+ * where `load` is 1 for a clean fan, less for one slowed by dust and 0 for a
+ * blocked rotor. The sense output is open collector: it pulls PD6 low for half of
+ * each of the `pulses` periods per turn and releases it otherwise, so the pin only
+ * reads high through a pull-up. The model is advanced at every tach edge and at
+ * least every SIM_FAN_STEP_MS, so the edges fall on the cycle they are due.
+ *
+ * The motor switching couples into the sense wire: with SIM_fanSetSpikes(), while
+ * the fan is driven, the released line is pulled low for a few cycles every
+ * SIM_FAN_SPIKE_US. Only the input capture noise canceler filters spikes that short.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "sim.h"
+#include <stdio.h>
+#include <math.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Rotor time constant, in seconds */
+#define SIM_FAN_TAU_S   0.3
+/* Longest time between two model updates, in milliseconds */
+#define SIM_FAN_STEP_MS 1.0
+/* Below this speed, and not driven faster, friction stops the rotor */
+#define SIM_FAN_STOP_RPM 30.0
+
+/* Interval between spikes on the sense wire, one fan PWM period at 7.8 kHz */
+#define SIM_FAN_SPIKE_US 128
+
+#define SIM_FAN_PORT_D  3
+#define SIM_FAN_TACH    6
+
+/*******************************************************************************
+ *                                Global Variables                             *
+ *******************************************************************************/
+
+static uint8_t g_fanActive;
+static double g_fanMaxRpm;
+static uint8_t g_fanPulses;
+static double g_fanLoad;
+static double g_fanRpm;
+/* Progress toward the next tach edge, in half pulses (0 to 1) */
+static double g_fanPhase;
+static uint8_t g_fanPulledLow;
+static uint64_t g_fanLastCycle;
+static uint64_t g_fanNextCycle;
+static uint32_t g_fanPulseCount;
+/* Spike length in cycles (0 for none), the next spike and the end of the present one */
+static uint32_t g_fanSpikeCycles;
+static uint64_t g_fanNextSpike;
+static uint64_t g_fanSpikeEnd;
+static uint8_t g_fanSpiking;
+static uint32_t g_fanSpikeCount;
+
+/*******************************************************************************
+ *                                Functions Definitions                        *
+ *******************************************************************************/
+
+/**
+ * @brief Connects the fan model, at rest, to the tachometer pin.
+ *
+ * @param a_maxRpm Speed at full drive.
+ * @param a_pulses Tach pulses per turn.
+ */
+void SIM_fanStart(double a_maxRpm, uint8_t a_pulses) {
+    g_fanActive = 1;
+    g_fanMaxRpm = a_maxRpm;
+    g_fanPulses = a_pulses;
+    g_fanLoad = 1.0;
+    g_fanRpm = 0;
+    g_fanPhase = 0;
+    g_fanPulledLow = 0;
+    g_fanLastCycle = SIM_getCycles();
+    g_fanNextCycle = g_fanLastCycle;
+    SIM_releasePinInput(SIM_FAN_PORT_D, SIM_FAN_TACH);
+}
+
+/**
+ * @brief Sets the mechanical load: 1 for a clean fan, 0 for a blocked rotor.
+ */
+void SIM_fanSetLoad(double a_load) {
+    g_fanLoad = a_load;
+}
+
+/**
+ * @brief Sets the length of the spikes on the sense wire, in cycles; 0 stops them.
+ */
+void SIM_fanSetSpikes(uint32_t a_cycles) {
+    g_fanSpikeCycles = a_cycles;
+    g_fanNextSpike = SIM_getCycles();
+}
+
+/**
+ * @brief Starts and ends the spikes on the sense wire.
+ */
+static void SIM_fanSpikeTick(uint64_t a_now) {
+    if (g_fanSpiking) {
+        if (a_now >= g_fanSpikeEnd) {
+            g_fanSpiking = 0;
+            if (!g_fanPulledLow) {
+                SIM_releasePinInput(SIM_FAN_PORT_D, SIM_FAN_TACH);
+            }
+        }
+    } else if (a_now >= g_fanNextSpike) {
+        g_fanNextSpike = a_now + SIM_FAN_SPIKE_US * (F_CPU / 1000000UL);
+        if (!g_fanPulledLow && SIM_getFanDuty() > 0) {
+            g_fanSpiking = 1;
+            g_fanSpikeEnd = a_now + g_fanSpikeCycles;
+            g_fanSpikeCount++;
+            SIM_setPinInput(SIM_FAN_PORT_D, SIM_FAN_TACH, 0);
+        }
+    }
+}
+
+/**
+ * @brief Advances the rotor when an edge or the next step is due; called every cycle.
+ */
+void SIM_fanTick(void) {
+    uint64_t l_now = SIM_getCycles();
+    double l_seconds;
+    double l_target;
+    double l_rpm;
+    double l_rate;
+    double l_next;
+
+    if (g_fanActive && g_fanSpikeCycles > 0) {
+        SIM_fanSpikeTick(l_now);
+    }
+    if (!g_fanActive || l_now < g_fanNextCycle) {
+        return;
+    }
+    l_seconds = (double) (l_now - g_fanLastCycle) / (double) F_CPU;
+    l_target = g_fanMaxRpm * SIM_getFanDuty() * g_fanLoad;
+    l_rpm = l_target + (g_fanRpm - l_target) * exp(-l_seconds / SIM_FAN_TAU_S);
+    if (l_rpm < SIM_FAN_STOP_RPM && l_target < SIM_FAN_STOP_RPM) {
+        l_rpm = 0;
+    }
+    /* Half pulses turned, with the mean speed over the step */
+    g_fanPhase += (g_fanRpm + l_rpm) / 2.0 / 60.0 * l_seconds * 2.0 * g_fanPulses;
+    g_fanRpm = l_rpm;
+    g_fanLastCycle = l_now;
+
+    if (g_fanPhase >= 1.0) {
+        g_fanPhase = fmod(g_fanPhase, 1.0);
+        g_fanPulledLow = !g_fanPulledLow;
+        if (g_fanPulledLow) {
+            g_fanPulseCount++;
+            SIM_setPinInput(SIM_FAN_PORT_D, SIM_FAN_TACH, 0);
+        } else if (!g_fanSpiking) {
+            SIM_releasePinInput(SIM_FAN_PORT_D, SIM_FAN_TACH);
+        }
+    }
+
+    /* Next edge at the present speed, or the next step if that is sooner */
+    l_rate = g_fanRpm / 60.0 * 2.0 * g_fanPulses;
+    l_next = SIM_FAN_STEP_MS / 1000.0;
+    if (l_rate > 0 && (1.0 - g_fanPhase) / l_rate < l_next) {
+        l_next = (1.0 - g_fanPhase) / l_rate;
+    }
+    g_fanNextCycle = l_now + 1 + (uint64_t) (l_next * (double) F_CPU);
+}
+
+/**
+ * @brief Gives the rotor speed; returns 0 if the model is not connected.
+ */
+int SIM_fanRpm(double *a_rpm) {
+    *a_rpm = g_fanRpm;
+    return g_fanActive;
+}
+
+/**
+ * @brief Prints the final speed and the number of tach pulses.
+ */
+void SIM_printFanStats(void) {
+    if (!g_fanActive) {
+        return;
+    }
+    printf("fan final      : %.0f rpm, %u tach pulses, %u spikes\n", g_fanRpm, g_fanPulseCount,
+            g_fanSpikeCount);
+}
@@ -0,0 +1,1037 @@
+/**
+ * @file sim_peripherals.c
+ * @brief Peripheral models of the simulated ATmega32 and the board around it.
+ *
+ * Models the four I/O ports, Timer 0, Timer 1 (normal mode and the PWM modes with
+ * ICR1 as TOP, and input capture on ICP1, with its noise canceler, for edges driven
+ * from outside), Timer 2
+ * (normal and CTC modes, from the I/O clock), the ADC (with auto-triggering from Timer 0), external interrupt 0 and
+ * an HD44780
+ * LCD wired as on the board (RS on PD0, E on PD1, D0-D7 on PORTC, and RW on PB2 for
+ * builds that define LCD_RW; the pin reads low otherwise). The LCD follows the
+ * function set command into 4-bit mode, where it only uses D4-D7 (PC4-PC7). The board's
+ * actuators (LEDs, motor driver, buzzer) are only observed, for the snapshot and the
+ * `SIM_TRACE` log.
+ *
+ * Interrupt flags that the AVR clears by writing a one (GIFR, TIFR, ADIF) live in
+ * shadow state. After the firmware accesses one of these registers through
+ * atmega32_regs.h, every flag bit that is still one in memory is cleared. That is
+ * exact for writes and read-modify-writes; a plain read, which a native build
+ * cannot tell apart from writing the same value back, also clears the flags it
+ * returned. Code that must look at a flag without clearing it reads through the
+ * read-only macros (TIFR_FLAGS), which do not report the access.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Data memory addresses of the modelled registers */
+#define SIM_ADCL   0x24
+#define SIM_ADCH   0x25
+#define SIM_ADCSRA 0x26
+#define SIM_ADMUX  0x27
+#define SIM_SFIOR  0x50
+#define SIM_ICR1   0x46
+#define SIM_OCR1B  0x48
+#define SIM_OCR1A  0x4A
+#define SIM_TCNT1  0x4C
+#define SIM_TCCR1B 0x4E
+#define SIM_TCCR1A 0x4F
+#define SIM_OCR2   0x43
+#define SIM_TCNT2  0x44
+#define SIM_TCCR2  0x45
+#define SIM_TCNT0  0x52
+#define SIM_TCCR0  0x53
+#define SIM_MCUCR  0x55
+#define SIM_TIFR   0x58
+#define SIM_TIMSK  0x59
+#define SIM_GIFR   0x5A
+#define SIM_GICR   0x5B
+#define SIM_OCR0   0x5C
+
+/* Port registers: PINx, DDRx and PORTx are consecutive, port A at the top */
+#define SIM_PORTS 4
+#define SIM_PIN_ADDRESS(port)  (0x39 - 3 * (port))
+#define SIM_DDR_ADDRESS(port)  (SIM_PIN_ADDRESS(port) + 1)
+#define SIM_PORT_ADDRESS(port) (SIM_PIN_ADDRESS(port) + 2)
+#define SIM_PORT_B 1
+#define SIM_PORT_C 2
+#define SIM_PORT_D 3
+
+/* Register bits */
+#define SIM_ADCSRA_ADEN 7
+#define SIM_ADCSRA_ADSC 6
+#define SIM_ADCSRA_ADATE 5
+#define SIM_ADCSRA_ADIF 4
+#define SIM_ADCSRA_ADIE 3
+#define SIM_ADMUX_ADLAR 5
+#define SIM_TCCR0_WGM00 6
+#define SIM_TCCR0_WGM01 3
+#define SIM_TCCR0_COM01 5
+#define SIM_TCCR1A_COM1A1 7
+#define SIM_TCCR1B_ICES1 6
+#define SIM_TCCR1B_ICNC1 7
+#define SIM_TCCR2_WGM21 3
+#define SIM_TIMSK_OCIE2 7
+#define SIM_TIMSK_TOIE2 6
+#define SIM_TIMSK_TICIE1 5
+#define SIM_TIMSK_OCIE1A 4
+#define SIM_TIMSK_OCIE1B 3
+#define SIM_TIMSK_TOIE1 2
+#define SIM_TIMSK_OCIE0 1
+#define SIM_TIMSK_TOIE0 0
+#define SIM_TIFR_OCF2   7
+#define SIM_TIFR_TOV2   6
+#define SIM_TIFR_ICF1   5
+#define SIM_TIFR_OCF1A  4
+#define SIM_TIFR_OCF1B  3
+#define SIM_TIFR_TOV1   2
+#define SIM_TIFR_OCF0   1
+#define SIM_TIFR_TOV0   0
+#define SIM_GICR_INT0   6
+#define SIM_GIFR_INTF0  6
+#define SIM_SFIOR_PUD   2
+#define SIM_SFIOR_ADTS0 5
+
+/* Auto-trigger sources (ADTS2:0) that are modelled */
+#define SIM_ADTS_TIMER0_COMPARE  3
+#define SIM_ADTS_TIMER0_OVERFLOW 4
+
+/* Board wiring */
+#define SIM_INT0_BIT   2 /* PD2, flame sensor */
+#define SIM_LCD_RS_BIT 0 /* PD0 */
+#define SIM_LCD_E_BIT  1 /* PD1 */
+#define SIM_LCD_RW_BIT 2 /* PB2 */
+#define SIM_BUZZER_BIT 3 /* PD3 */
+#define SIM_MOTOR_IN1  0 /* PB0 */
+#define SIM_MOTOR_IN2  1 /* PB1 */
+#define SIM_ICP1_BIT   6 /* PD6, fan tachometer */
+
+/**
+ * @brief ADC clock cycles per conversion.
+ */
+#define SIM_ADC_CONVERSION_CLOCKS 13
+
+/**
+ * @brief ADC clock cycles from the start of a conversion to the sample and hold,
+ * in half clocks: 1.5 when started by ADSC, 2 when auto-triggered.
+ */
+#define SIM_ADC_HOLD_HALF_CLOCKS           3
+#define SIM_ADC_TRIGGERED_HOLD_HALF_CLOCKS 4
+
+/**
+ * @brief HD44780 execution times in CPU cycles (1.52 ms for clear/home, 37 us otherwise).
+ */
+#define SIM_LCD_SLOW_COMMAND_CYCLES ((uint64_t) F_CPU / 1000000UL * 1520)
+#define SIM_LCD_FAST_COMMAND_CYCLES ((uint64_t) F_CPU / 1000000UL * 37)
+
+#define SIM_LCD_DDRAM_SIZE 0x80
+#define SIM_LCD_COLUMNS    16
+
+/*******************************************************************************
+ *                                Model State                                  *
+ *******************************************************************************/
+
+/* Write-one-to-clear flags, and the register the firmware accessed last */
+static uint8_t g_tifr;
+static uint8_t g_gifr;
+static uint8_t g_adif;
+static uint8_t g_accessedRegister;
+
+/* Pins driven from outside the chip */
+static uint8_t g_extDriven[SIM_PORTS];
+static uint8_t g_extLevel[SIM_PORTS];
+
+/* Timer 0 */
+static uint16_t g_timer0Prescale;
+static uint8_t g_timer0Down;
+
+/* Timer 1 */
+static uint16_t g_timer1Prescale;
+static uint8_t g_timer1Down;
+
+/* Cycles a new ICP1 level must hold to pass the noise canceler (ICNC1) */
+#define SIM_ICNC1_CYCLES 4
+
+/* Level of ICP1 as the edge detector sees it, after the noise canceler */
+static uint8_t g_icp1Level;
+/* A new level is waiting out the noise canceler until g_icp1SettleCycle */
+static uint8_t g_icp1Settling;
+static uint64_t g_icp1SettleCycle;
+/* Captures taken on falling [0] and rising [1] edges */
+static uint32_t g_icp1Captures[2];
+
+/* Timer 2 */
+static uint16_t g_timer2Prescale;
+
+/* ADC */
+static double g_adcInput[SIM_ADC_CHANNELS];
+static double g_adcNoise[SIM_ADC_CHANNELS];
+static uint32_t g_noiseState = 0x2545F491u;
+static uint8_t g_adcBusy;
+static uint8_t g_adcChannel;
+static uint32_t g_adcRemaining;
+static uint32_t g_adcConversions;
+/* Noise from CPU and I/O activity, absent when the whole conversion runs in ADC
+ * Noise Reduction sleep, and whether the running conversion has stayed quiet */
+static double g_adcCpuNoise;
+static uint8_t g_adcQuiet;
+static uint32_t g_adcQuietConversions;
+/* Motor switching noise, on conversions that sample shortly after an OC0 edge */
+static double g_adcPwmNoise;
+static uint64_t g_adcPwmNoiseCycles;
+static uint32_t g_adcHoldRemaining;
+static uint8_t g_adcSwitching;
+static uint32_t g_adcSwitchingConversions;
+static uint32_t g_adcTriggeredConversions;
+static uint8_t g_oc0Switched;
+static uint64_t g_oc0EdgeCycle;
+
+/* External interrupt 0 */
+static uint8_t g_int0Level;
+
+/* HD44780 */
+static char g_lcdDdram[SIM_LCD_DDRAM_SIZE];
+static uint8_t g_lcdAddress;
+static uint8_t g_lcdEnable;
+static uint64_t g_lcdReadyCycle;
+static uint32_t g_lcdCommands;
+static uint32_t g_lcdData;
+static uint32_t g_lcdTooEarly;
+static uint32_t g_lcdReads;
+static uint8_t g_lcdSelect;
+static uint8_t g_lcdReading;
+static uint8_t g_lcdDriving;
+static uint8_t g_lcdBus;
+static uint8_t g_lcdFourBit;
+static uint8_t g_lcdSecondNibble;
+static uint8_t g_lcdLatched;
+static uint64_t g_lcdWriteStart;
+
+/* Actuators */
+static uint8_t g_lastOcr0;
+static uint32_t g_ocr0Changes;
+static uint8_t g_ocr0MaxStep;
+static uint32_t g_actuatorState = UINT32_MAX;
+static uint8_t g_trace;
+
+/*******************************************************************************
+ *                                Helpers                                      *
+ *******************************************************************************/
+
+#define SIM_BIT(reg, bit) (((reg) >> (bit)) & 1)
+
+/**
+ * @brief Returns the level seen on a port's pins, combining outputs and inputs.
+ */
+static uint8_t SIM_pinLevels(uint8_t a_port) {
+    uint8_t l_ddr = SIM_ioMemory[SIM_DDR_ADDRESS(a_port)];
+    uint8_t l_port = SIM_ioMemory[SIM_PORT_ADDRESS(a_port)];
+    uint8_t l_pullUp = SIM_BIT(SIM_ioMemory[SIM_SFIOR], SIM_SFIOR_PUD) ? 0 : l_port;
+    uint8_t l_ext = (g_extLevel[a_port] & g_extDriven[a_port])
+            | (l_pullUp & ~g_extDriven[a_port]);
+
+    if (a_port == SIM_PORT_C && g_lcdDriving) {
+        uint8_t l_mask = g_lcdFourBit ? 0xF0 : 0xFF;
+        l_ext = (uint8_t) ((l_ext & ~l_mask) | (g_lcdBus & l_mask));
+    }
+
+    return (uint8_t) ((l_port & l_ddr) | (l_ext & ~l_ddr));
+}
+
+/**
+ * @brief Returns the Timer 0 prescaler for the current clock select bits, 0 if stopped.
+ */
+static uint16_t SIM_timer0Prescaler(void) {
+    static const uint16_t l_prescalers[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+    return l_prescalers[SIM_ioMemory[SIM_TCCR0] & 0x07];
+}
+
+/**
+ * @brief Reads a 16-bit register from the register file.
+ */
+static uint16_t SIM_read16(uint8_t a_address) {
+    return (uint16_t) (SIM_ioMemory[a_address] | (SIM_ioMemory[a_address + 1] << 8));
+}
+
+/**
+ * @brief Returns the Timer 1 prescaler for the current clock select bits, 0 if stopped.
+ */
+static uint16_t SIM_timer1Prescaler(void) {
+    static const uint16_t l_prescalers[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+    return l_prescalers[SIM_ioMemory[SIM_TCCR1B] & 0x07];
+}
+
+/**
+ * @brief Returns the Timer 2 prescaler for the current clock select bits, 0 if stopped.
+ */
+static uint16_t SIM_timer2Prescaler(void) {
+    static const uint16_t l_prescalers[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+    return l_prescalers[SIM_ioMemory[SIM_TCCR2] & 0x07];
+}
+
+/**
+ * @brief Returns the Timer 1 waveform generation mode (WGM13:0).
+ */
+static uint8_t SIM_timer1Mode(void) {
+    return (uint8_t) ((SIM_ioMemory[SIM_TCCR1A] & 0x03) | ((SIM_ioMemory[SIM_TCCR1B] >> 1) & 0x0C));
+}
+
+/**
+ * @brief Returns the fan drive set by the PWM on OC1A (PD5) or OC0 (PB3), from 0 to 1.
+ */
+static double SIM_fanDrive(void) {
+    uint8_t l_mode = SIM_timer1Mode();
+    uint16_t l_top = SIM_read16(SIM_ICR1);
+    uint16_t l_ocr = SIM_read16(SIM_OCR1A);
+
+    if ((l_mode == 14 || l_mode == 10) && SIM_BIT(SIM_ioMemory[SIM_TCCR1A], SIM_TCCR1A_COM1A1)
+            && l_top != 0) {
+        if (l_ocr >= l_top) {
+            return 1.0;
+        }
+        return (l_mode == 14) ? (l_ocr + 1.0) / (l_top + 1.0) : (double) l_ocr / l_top;
+    }
+    return SIM_ioMemory[SIM_OCR0] / 255.0;
+}
+
+/**
+ * @brief Returns the ADC prescaler for the current ADPS bits.
+ */
+static uint8_t SIM_adcPrescaler(void) {
+    static const uint8_t l_prescalers[8] = { 2, 2, 4, 8, 16, 32, 64, 128 };
+    return l_prescalers[SIM_ioMemory[SIM_ADCSRA] & 0x07];
+}
+
+/**
+ * @brief Executes one byte written to the LCD.
+ *
+ * @param a_start Cycle the write began (the first nibble in 4-bit mode), when
+ *                the LCD must already have finished the previous one.
+ */
+static void SIM_lcdWrite(uint8_t a_isData, uint8_t a_value, uint64_t a_start) {
+    uint64_t l_now = SIM_getCycles();
+
+    if (a_start < g_lcdReadyCycle) {
+        g_lcdTooEarly++;
+    }
+    if (a_isData) {
+        g_lcdData++;
+        g_lcdDdram[g_lcdAddress] = (char) a_value;
+        g_lcdAddress = (g_lcdAddress + 1) & (SIM_LCD_DDRAM_SIZE - 1);
+        g_lcdReadyCycle = l_now + SIM_LCD_FAST_COMMAND_CYCLES;
+        return;
+    }
+    g_lcdCommands++;
+    if (a_value & 0x80) {
+        g_lcdAddress = a_value & 0x7F;
+        g_lcdReadyCycle = l_now + SIM_LCD_FAST_COMMAND_CYCLES;
+    } else if (a_value == 0x01) {
+        memset(g_lcdDdram, ' ', sizeof(g_lcdDdram));
+        g_lcdAddress = 0;
+        g_lcdReadyCycle = l_now + SIM_LCD_SLOW_COMMAND_CYCLES;
+    } else if ((a_value & 0xFE) == 0x02) {
+        g_lcdAddress = 0;
+        g_lcdReadyCycle = l_now + SIM_LCD_SLOW_COMMAND_CYCLES;
+    } else if ((a_value & 0xE0) == 0x20) {
+        /* Function set: only the interface width (DL) is modelled */
+        g_lcdFourBit = !(a_value & 0x10);
+        g_lcdSecondNibble = 0;
+        g_lcdReadyCycle = l_now + SIM_LCD_FAST_COMMAND_CYCLES;
+    } else {
+        /* Display control and entry mode: accepted, not modelled */
+        g_lcdReadyCycle = l_now + SIM_LCD_FAST_COMMAND_CYCLES;
+    }
+}
+
+/**
+ * @brief Returns the byte the LCD drives on the data bus during a read.
+ */
+static uint8_t SIM_lcdReadValue(uint8_t a_isData) {
+    if (a_isData) {
+        return (uint8_t) g_lcdDdram[g_lcdAddress];
+    }
+    return (uint8_t) ((SIM_getCycles() < g_lcdReadyCycle ? 0x80 : 0x00) | g_lcdAddress);
+}
+
+/**
+ * @brief Packs the observed actuator outputs into one word, to detect changes.
+ */
+static uint32_t SIM_actuatorState(void) {
+    uint8_t l_portB = SIM_pinLevels(SIM_PORT_B) & SIM_ioMemory[SIM_DDR_ADDRESS(SIM_PORT_B)];
+    uint8_t l_portD = SIM_pinLevels(SIM_PORT_D) & SIM_ioMemory[SIM_DDR_ADDRESS(SIM_PORT_D)];
+
+    return (uint32_t) (l_portB & 0xE3) | ((uint32_t) SIM_BIT(l_portD, SIM_BUZZER_BIT) << 8)
+            | ((uint32_t) (SIM_fanDrive() * 255.0 + 0.5) << 16);
+}
+
+/**
+ * @brief Starts an ADC conversion on the channel selected in ADMUX.
+ *
+ * @param a_triggered 1 if an auto-trigger event started it, 0 for ADSC or sleep.
+ */
+static void SIM_adcStart(uint8_t a_triggered) {
+    uint32_t l_holdHalfClocks = a_triggered ? SIM_ADC_TRIGGERED_HOLD_HALF_CLOCKS
+            : SIM_ADC_HOLD_HALF_CLOCKS;
+
+    g_adcBusy = 1;
+    g_adcChannel = SIM_ioMemory[SIM_ADMUX] & 0x07;
+    g_adcRemaining = (uint32_t) SIM_ADC_CONVERSION_CLOCKS * SIM_adcPrescaler();
+    g_adcHoldRemaining = g_adcRemaining - l_holdHalfClocks * SIM_adcPrescaler() / 2;
+    g_adcQuiet = (SIM_getSleepMode() == SIM_SLEEP_ADC_NOISE_REDUCTION);
+    g_adcSwitching = 0;
+    g_adcTriggeredConversions += a_triggered;
+}
+
+/**
+ * @brief Starts a conversion if the Timer 0 flag selected by ADTS has just gone high.
+ *
+ * Only the Timer 0 sources are modelled. As on the chip, an event that comes while
+ * a conversion runs is lost, and a flag that stays high triggers nothing more.
+ *
+ * @param a_tifrBefore TIFR before the Timer 0 step.
+ */
+static void SIM_adcAutoTrigger(uint8_t a_tifrBefore) {
+    uint8_t l_adcsra = SIM_ioMemory[SIM_ADCSRA];
+    uint8_t l_source = (SIM_ioMemory[SIM_SFIOR] >> SIM_SFIOR_ADTS0) & 0x07;
+    uint8_t l_flag;
+
+    if (!SIM_BIT(l_adcsra, SIM_ADCSRA_ADEN) || !SIM_BIT(l_adcsra, SIM_ADCSRA_ADATE)
+            || g_adcBusy) {
+        return;
+    }
+    if (l_source == SIM_ADTS_TIMER0_OVERFLOW) {
+        l_flag = SIM_TIFR_TOV0;
+    } else if (l_source == SIM_ADTS_TIMER0_COMPARE) {
+        l_flag = SIM_TIFR_OCF0;
+    } else {
+        return;
+    }
+    if (SIM_BIT(g_tifr & ~a_tifrBefore, l_flag)) {
+        SIM_ioMemory[SIM_ADCSRA] |= (1 << SIM_ADCSRA_ADSC);
+        SIM_adcStart(1);
+    }
+}
+
+/**
+ * @brief Returns a uniformly distributed number in (0, 1), from a fixed seed so
+ * runs are repeatable.
+ */
+static double SIM_noiseUniform(void) {
+    g_noiseState ^= g_noiseState << 13;
+    g_noiseState ^= g_noiseState >> 17;
+    g_noiseState ^= g_noiseState << 5;
+    return (g_noiseState + 0.5) / 4294967296.0;
+}
+
+/**
+ * @brief Returns a normally distributed number with the given standard deviation.
+ */
+static double SIM_noiseGaussian(double a_rms) {
+    /* Box-Muller transform of two uniform numbers into a normal one */
+    return a_rms * sqrt(-2.0 * log(SIM_noiseUniform())) * cos(2.0 * M_PI * SIM_noiseUniform());
+}
+
+/**
+ * @brief Converts the analog input of a channel: adds its noise, rounds and clamps.
+ *
+ * The CPU noise is left out if the conversion ran entirely in ADC Noise Reduction
+ * sleep, and the switching noise is only added if the sample was held shortly after
+ * an OC0 edge.
+ */
+static uint16_t SIM_adcSample(uint8_t a_channel) {
+    double l_code;
+
+    SIM_plantUpdate();
+    l_code = g_adcInput[a_channel];
+
+    if (g_adcNoise[a_channel] > 0) {
+        l_code += SIM_noiseGaussian(g_adcNoise[a_channel]);
+    }
+    if (g_adcCpuNoise > 0 && !g_adcQuiet) {
+        l_code += SIM_noiseGaussian(g_adcCpuNoise);
+    }
+    if (g_adcSwitching) {
+        l_code += SIM_noiseGaussian(g_adcPwmNoise);
+    }
+    l_code = floor(l_code + 0.5);
+    return (uint16_t) (l_code < 0 ? 0 : (l_code > 1023 ? 1023 : l_code));
+}
+
+/**
+ * @brief Completes the running ADC conversion.
+ */
+static void SIM_adcComplete(void) {
+    uint16_t l_result = SIM_adcSample(g_adcChannel);
+
+    if (SIM_BIT(SIM_ioMemory[SIM_ADMUX], SIM_ADMUX_ADLAR)) {
+        l_result <<= 6;
+    }
+    SIM_ioMemory[SIM_ADCL] = (uint8_t) l_result;
+    SIM_ioMemory[SIM_ADCH] = (uint8_t) (l_result >> 8);
+    SIM_ioMemory[SIM_ADCSRA] &= ~(1 << SIM_ADCSRA_ADSC);
+    g_adif = 1;
+    g_adcBusy = 0;
+    g_adcConversions++;
+    g_adcQuietConversions += g_adcQuiet;
+    g_adcSwitchingConversions += g_adcSwitching;
+}
+
+/*******************************************************************************
+ *                                Functions Definitions                        *
+ *******************************************************************************/
+
+/**
+ * @brief Puts the chip and the board in their power-on state.
+ */
+void SIM_peripheralsReset(void) {
+    memset((void *) SIM_ioMemory, 0, SIM_IO_MEMORY_SIZE);
+    memset(g_lcdDdram, ' ', sizeof(g_lcdDdram));
+    g_trace = getenv("SIM_TRACE") != NULL;
+}
+
+/**
+ * @brief Reacts to the current register contents.
+ *
+ * Called before every simulated cycle batch: recomputes the input pins, starts ADC
+ * conversions, detects INT0 and LCD enable edges and republishes the interrupt flags.
+ */
+void SIM_peripheralsSample(void) {
+    uint8_t l_port;
+    uint8_t l_portD;
+    uint8_t l_level;
+    uint8_t l_adcsra;
+
+    /* Flags still set after a firmware access were written (or read) as one */
+    switch (g_accessedRegister) {
+    case SIM_TIFR:
+        g_tifr &= ~SIM_ioMemory[SIM_TIFR];
+        break;
+    case SIM_GIFR:
+        g_gifr &= ~SIM_ioMemory[SIM_GIFR];
+        break;
+    case SIM_ADCSRA:
+        g_adif &= ~SIM_BIT(SIM_ioMemory[SIM_ADCSRA], SIM_ADCSRA_ADIF);
+        break;
+    default:
+        break;
+    }
+    g_accessedRegister = 0;
+
+    for (l_port = 0; l_port < SIM_PORTS; l_port++) {
+        SIM_ioMemory[SIM_PIN_ADDRESS(l_port)] = SIM_pinLevels(l_port);
+    }
+    l_portD = SIM_ioMemory[SIM_PIN_ADDRESS(SIM_PORT_D)];
+
+    /* External interrupt 0: edges set INTF0, the low level is handled as pending */
+    l_level = SIM_BIT(l_portD, SIM_INT0_BIT);
+    if (l_level != g_int0Level) {
+        uint8_t l_sense = SIM_ioMemory[SIM_MCUCR] & 0x03;
+        /* Edge detection needs the I/O clock, which ADC Noise Reduction sleep stops */
+        if (SIM_getSleepMode() == SIM_SLEEP_ADC_NOISE_REDUCTION) {
+            l_sense = 0;
+        }
+        if (l_sense == 1 || (l_sense == 2 && !l_level) || (l_sense == 3 && l_level)) {
+            g_gifr |= (1 << SIM_GIFR_INTF0);
+        }
+        g_int0Level = l_level;
+    }
+
+    /* HD44780: RS and RW are taken when E rises. For a read it drives the bus
+     * while E is high, for a write it latches the bus on the falling edge of E.
+     * In 4-bit mode every byte takes two E pulses, high nibble first */
+    l_level = SIM_BIT(l_portD, SIM_LCD_E_BIT);
+    if (l_level && !g_lcdEnable) {
+        g_lcdSelect = SIM_BIT(l_portD, SIM_LCD_RS_BIT);
+        g_lcdReading = SIM_BIT(SIM_ioMemory[SIM_PIN_ADDRESS(SIM_PORT_B)], SIM_LCD_RW_BIT);
+        if (g_lcdReading) {
+            if (!g_lcdSecondNibble) {
+                g_lcdLatched = SIM_lcdReadValue(g_lcdSelect);
+                g_lcdReads++;
+            }
+            g_lcdBus = g_lcdSecondNibble ? (uint8_t) (g_lcdLatched << 4) : g_lcdLatched;
+            g_lcdDriving = 1;
+        }
+    } else if (!l_level && g_lcdEnable) {
+        uint8_t l_bus = SIM_ioMemory[SIM_PIN_ADDRESS(SIM_PORT_C)];
+
+        if (g_lcdFourBit && !g_lcdSecondNibble) {
+            g_lcdLatched = g_lcdReading ? g_lcdLatched : (l_bus & 0xF0);
+            g_lcdWriteStart = SIM_getCycles();
+            g_lcdSecondNibble = 1;
+        } else {
+            if (g_lcdFourBit) {
+                l_bus = (uint8_t) (g_lcdLatched | (l_bus >> 4));
+                g_lcdSecondNibble = 0;
+            } else {
+                g_lcdWriteStart = SIM_getCycles();
+            }
+            if (!g_lcdReading) {
+                SIM_lcdWrite(g_lcdSelect, l_bus, g_lcdWriteStart);
+            } else if (g_lcdSelect) {
+                g_lcdAddress = (g_lcdAddress + 1) & (SIM_LCD_DDRAM_SIZE - 1);
+            }
+        }
+        g_lcdDriving = 0;
+    }
+    g_lcdEnable = l_level;
+    SIM_ioMemory[SIM_PIN_ADDRESS(SIM_PORT_C)] = SIM_pinLevels(SIM_PORT_C);
+
+    /* ADC: a one in ADSC starts a conversion; ADSC stays high until it completes */
+    l_adcsra = SIM_ioMemory[SIM_ADCSRA];
+    if (!SIM_BIT(l_adcsra, SIM_ADCSRA_ADEN)) {
+        g_adcBusy = 0;
+        l_adcsra &= ~(1 << SIM_ADCSRA_ADSC);
+    } else if (g_adcBusy) {
+        l_adcsra |= (1 << SIM_ADCSRA_ADSC);
+    } else if (SIM_BIT(l_adcsra, SIM_ADCSRA_ADSC)) {
+        SIM_adcStart(0);
+    }
+    SIM_ioMemory[SIM_ADCSRA] = (uint8_t) ((l_adcsra & ~(1 << SIM_ADCSRA_ADIF))
+            | (g_adif << SIM_ADCSRA_ADIF));
+    SIM_ioMemory[SIM_TIFR] = g_tifr;
+    SIM_ioMemory[SIM_GIFR] = g_gifr;
+
+    /* Actuators */
+    if (SIM_ioMemory[SIM_OCR0] != g_lastOcr0) {
+        uint8_t l_step = (uint8_t) abs((int) SIM_ioMemory[SIM_OCR0] - (int) g_lastOcr0);
+
+        if (l_step > g_ocr0MaxStep) {
+            g_ocr0MaxStep = l_step;
+        }
+        g_lastOcr0 = SIM_ioMemory[SIM_OCR0];
+        g_ocr0Changes++;
+    }
+    if (g_trace && SIM_actuatorState() != g_actuatorState) {
+        g_actuatorState = SIM_actuatorState();
+        printf("[%10.3f ms] ", SIM_getTimeMs());
+        SIM_printSnapshot();
+    }
+}
+
+/**
+ * @brief Hands an ICP1 level to the edge detector; captures TCNT1 into ICR1 on the
+ * edge ICES1 selects.
+ *
+ * ICR1 is TOP in the PWM modes and not written.
+ */
+static void SIM_inputCaptureEdge(uint8_t a_level) {
+    uint8_t l_mode = SIM_timer1Mode();
+
+    g_icp1Level = a_level;
+    if (a_level == SIM_BIT(SIM_ioMemory[SIM_TCCR1B], SIM_TCCR1B_ICES1) && l_mode != 14
+            && l_mode != 10) {
+        SIM_ioMemory[SIM_ICR1] = SIM_ioMemory[SIM_TCNT1];
+        SIM_ioMemory[SIM_ICR1 + 1] = SIM_ioMemory[SIM_TCNT1 + 1];
+        g_tifr |= (1 << SIM_TIFR_ICF1);
+        SIM_ioMemory[SIM_TIFR] = g_tifr;
+        g_icp1Captures[a_level]++;
+    }
+}
+
+/**
+ * @brief Passes an ICP1 level that has held through the noise canceler.
+ */
+static void SIM_inputCaptureSettle(void) {
+    if (g_icp1Settling && SIM_getCycles() >= g_icp1SettleCycle) {
+        g_icp1Settling = 0;
+        SIM_inputCaptureEdge(SIM_BIT(SIM_pinLevels(SIM_PORT_D), SIM_ICP1_BIT));
+    }
+}
+
+/**
+ * @brief Advances the clocked peripherals by one CPU cycle.
+ *
+ * The timers run on the I/O clock and halt in ADC Noise Reduction sleep.
+ */
+void SIM_peripheralsTick(void) {
+    uint16_t l_prescaler = SIM_timer0Prescaler();
+
+    SIM_fanTick();
+    if (g_adcBusy) {
+        if (--g_adcRemaining == g_adcHoldRemaining) {
+            /* Sample and hold: the motor is still ringing if OC0 has just switched */
+            g_adcSwitching = g_adcPwmNoise > 0 && g_oc0Switched && SIM_getFanDuty() > 0
+                    && SIM_getCycles() - g_oc0EdgeCycle < g_adcPwmNoiseCycles;
+        }
+        if (g_adcRemaining == 0) {
+            SIM_adcComplete();
+            SIM_ioMemory[SIM_ADCSRA] |= (1 << SIM_ADCSRA_ADIF);
+        }
+    }
+    if (SIM_getSleepMode() == SIM_SLEEP_ADC_NOISE_REDUCTION) {
+        return;
+    }
+    g_adcQuiet = 0;
+    SIM_inputCaptureSettle();
+
+    if (l_prescaler && ++g_timer0Prescale >= l_prescaler) {
+        uint8_t l_tccr0 = SIM_ioMemory[SIM_TCCR0];
+        uint8_t l_count = SIM_ioMemory[SIM_TCNT0];
+        uint8_t l_ocr0 = SIM_ioMemory[SIM_OCR0];
+        uint8_t l_wgm = (uint8_t) (SIM_BIT(l_tccr0, SIM_TCCR0_WGM00)
+                | (SIM_BIT(l_tccr0, SIM_TCCR0_WGM01) << 1));
+        uint8_t l_tifrBefore = g_tifr;
+
+        g_timer0Prescale = 0;
+        if (l_wgm == 1) {
+            /* Phase correct PWM: up to 0xFF, down to 0, overflow at the bottom */
+            if (g_timer0Down) {
+                if (--l_count == 0) {
+                    g_timer0Down = 0;
+                    g_tifr |= (1 << SIM_TIFR_TOV0);
+                }
+            } else if (++l_count == 0xFF) {
+                g_timer0Down = 1;
+            }
+        } else if (l_wgm == 2 && l_count == l_ocr0) {
+            /* CTC: clear on compare match */
+            l_count = 0;
+        } else if (++l_count == 0) {
+            g_tifr |= (1 << SIM_TIFR_TOV0);
+        }
+        if (l_count == l_ocr0) {
+            g_tifr |= (1 << SIM_TIFR_OCF0);
+        }
+        /* Fast PWM on OC0 switches at BOTTOM and on the match, unless OCR0 is TOP */
+        if (l_wgm == 3 && SIM_BIT(l_tccr0, SIM_TCCR0_COM01) && l_ocr0 != 0xFF
+                && (l_count == 0 || l_count == l_ocr0)) {
+            g_oc0Switched = 1;
+            g_oc0EdgeCycle = SIM_getCycles();
+        }
+        SIM_ioMemory[SIM_TCNT0] = l_count;
+        SIM_ioMemory[SIM_TIFR] = g_tifr;
+        SIM_adcAutoTrigger(l_tifrBefore);
+    }
+
+    l_prescaler = SIM_timer1Prescaler();
+    if (l_prescaler && ++g_timer1Prescale >= l_prescaler) {
+        uint16_t l_count = SIM_read16(SIM_TCNT1);
+        uint16_t l_top = SIM_read16(SIM_ICR1);
+        uint8_t l_mode = SIM_timer1Mode();
+
+        g_timer1Prescale = 0;
+        if (l_mode == 14) {
+            /* Fast PWM, ICR1 as TOP: overflow (and ICF1) at TOP, then back to 0 */
+            if (l_count >= l_top) {
+                l_count = 0;
+                g_tifr |= (1 << SIM_TIFR_TOV1) | (1 << SIM_TIFR_ICF1);
+            } else {
+                l_count++;
+            }
+        } else if (l_mode == 10) {
+            /* Phase correct PWM, ICR1 as TOP: up to TOP, down to 0, overflow at the bottom */
+            if (g_timer1Down) {
+                if (l_count == 0 || --l_count == 0) {
+                    g_timer1Down = 0;
+                    g_tifr |= (1 << SIM_TIFR_TOV1);
+                }
+            } else if (++l_count >= l_top) {
+                g_timer1Down = 1;
+                g_tifr |= (1 << SIM_TIFR_ICF1);
+            }
+        } else if (++l_count == 0) {
+            /* Normal mode: 0x0000 to 0xFFFF, compare units never reset the count */
+            g_tifr |= (1 << SIM_TIFR_TOV1);
+        }
+        if (l_count == SIM_read16(SIM_OCR1A)) {
+            g_tifr |= (1 << SIM_TIFR_OCF1A);
+        }
+        if (l_count == SIM_read16(SIM_OCR1B)) {
+            g_tifr |= (1 << SIM_TIFR_OCF1B);
+        }
+        SIM_ioMemory[SIM_TCNT1] = (uint8_t) l_count;
+        SIM_ioMemory[SIM_TCNT1 + 1] = (uint8_t) (l_count >> 8);
+        SIM_ioMemory[SIM_TIFR] = g_tifr;
+    }
+
+    l_prescaler = SIM_timer2Prescaler();
+    if (l_prescaler && ++g_timer2Prescale >= l_prescaler) {
+        uint8_t l_count = SIM_ioMemory[SIM_TCNT2];
+        uint8_t l_ocr2 = SIM_ioMemory[SIM_OCR2];
+
+        g_timer2Prescale = 0;
+        if (SIM_BIT(SIM_ioMemory[SIM_TCCR2], SIM_TCCR2_WGM21) && l_count == l_ocr2) {
+            /* CTC: clear on compare match */
+            l_count = 0;
+        } else if (++l_count == 0) {
+            g_tifr |= (1 << SIM_TIFR_TOV2);
+        }
+        if (l_count == l_ocr2) {
+            g_tifr |= (1 << SIM_TIFR_OCF2);
+        }
+        SIM_ioMemory[SIM_TCNT2] = l_count;
+        SIM_ioMemory[SIM_TIFR] = g_tifr;
+    }
+}
+
+/**
+ * @brief Notes a register access made through atmega32_regs.h.
+ *
+ * The access itself happens after this returns; the next sample looks at what
+ * the firmware left in the register.
+ *
+ * @param a_address Data memory address of the accessed register.
+ */
+void SIM_peripheralsAccess(uint8_t a_address) {
+    g_accessedRegister = a_address;
+}
+
+/**
+ * @brief Called as the core goes to sleep.
+ *
+ * Entering ADC Noise Reduction mode starts a conversion if the ADC is enabled and
+ * idle, as on the chip.
+ *
+ * @param a_mode The sleep mode (SIM_SLEEP_*).
+ */
+void SIM_peripheralsSleep(uint8_t a_mode) {
+    if (a_mode == SIM_SLEEP_ADC_NOISE_REDUCTION && !g_adcBusy
+            && SIM_BIT(SIM_ioMemory[SIM_ADCSRA], SIM_ADCSRA_ADEN)) {
+        SIM_ioMemory[SIM_ADCSRA] |= (1 << SIM_ADCSRA_ADSC);
+        SIM_adcStart(0);
+    }
+}
+
+/**
+ * @brief Returns the highest priority pending interrupt, or -1 if none is pending.
+ */
+int SIM_peripheralsPendingIrq(void) {
+    uint8_t l_timsk = SIM_ioMemory[SIM_TIMSK];
+
+    if (SIM_BIT(SIM_ioMemory[SIM_GICR], SIM_GICR_INT0)) {
+        if ((SIM_ioMemory[SIM_MCUCR] & 0x03) == 0 ? !g_int0Level
+                : SIM_BIT(g_gifr, SIM_GIFR_INTF0)) {
+            return SIM_IRQ_INT0;
+        }
+    }
+    if (SIM_BIT(l_timsk & g_tifr, SIM_TIMSK_OCIE2)) {
+        return SIM_IRQ_TIMER2_COMP;
+    }
+    if (SIM_BIT(l_timsk & g_tifr, SIM_TIMSK_TOIE2)) {
+        return SIM_IRQ_TIMER2_OVF;
+    }
+    if (SIM_BIT(l_timsk & g_tifr, SIM_TIMSK_TICIE1)) {
+        return SIM_IRQ_TIMER1_CAPT;
+    }
+    if (SIM_BIT(l_timsk & g_tifr, SIM_TIMSK_OCIE1A)) {
+        return SIM_IRQ_TIMER1_COMPA;
+    }
+    if (SIM_BIT(l_timsk & g_tifr, SIM_TIMSK_OCIE1B)) {
+        return SIM_IRQ_TIMER1_COMPB;
+    }
+    if (SIM_BIT(l_timsk & g_tifr, SIM_TIMSK_TOIE1)) {
+        return SIM_IRQ_TIMER1_OVF;
+    }
+    if (SIM_BIT(l_timsk & g_tifr, SIM_TIMSK_OCIE0)) {
+        return SIM_IRQ_TIMER0_COMP;
+    }
+    if (SIM_BIT(l_timsk & g_tifr, SIM_TIMSK_TOIE0)) {
+        return SIM_IRQ_TIMER0_OVF;
+    }
+    if (g_adif && SIM_BIT(SIM_ioMemory[SIM_ADCSRA], SIM_ADCSRA_ADIE)) {
+        return SIM_IRQ_ADC;
+    }
+    return -1;
+}
+
+/**
+ * @brief Clears the flag of an interrupt that is being serviced.
+ */
+void SIM_peripheralsAcknowledgeIrq(SIM_Irq a_irq) {
+    switch (a_irq) {
+    case SIM_IRQ_INT0:
+        g_gifr &= ~(1 << SIM_GIFR_INTF0);
+        break;
+    case SIM_IRQ_TIMER2_COMP:
+        g_tifr &= ~(1 << SIM_TIFR_OCF2);
+        break;
+    case SIM_IRQ_TIMER2_OVF:
+        g_tifr &= ~(1 << SIM_TIFR_TOV2);
+        break;
+    case SIM_IRQ_TIMER1_CAPT:
+        g_tifr &= ~(1 << SIM_TIFR_ICF1);
+        break;
+    case SIM_IRQ_TIMER1_COMPA:
+        g_tifr &= ~(1 << SIM_TIFR_OCF1A);
+        break;
+    case SIM_IRQ_TIMER1_COMPB:
+        g_tifr &= ~(1 << SIM_TIFR_OCF1B);
+        break;
+    case SIM_IRQ_TIMER1_OVF:
+        g_tifr &= ~(1 << SIM_TIFR_TOV1);
+        break;
+    case SIM_IRQ_TIMER0_COMP:
+        g_tifr &= ~(1 << SIM_TIFR_OCF0);
+        break;
+    case SIM_IRQ_TIMER0_OVF:
+        g_tifr &= ~(1 << SIM_TIFR_TOV0);
+        break;
+    case SIM_IRQ_ADC:
+        g_adif = 0;
+        break;
+    default:
+        break;
+    }
+    SIM_peripheralsSample();
+}
+
+/**
+ * @brief Follows an outside change of ICP1.
+ *
+ * Without ICNC1 the edge is seen on its cycle. With ICNC1 the new level must hold
+ * for SIM_ICNC1_CYCLES (SIM_inputCaptureSettle() takes it then, so the capture is
+ * that much later), and a pulse shorter than that is never seen.
+ */
+static void SIM_inputCaptureCheck(void) {
+    uint8_t l_level = SIM_BIT(SIM_pinLevels(SIM_PORT_D), SIM_ICP1_BIT);
+
+    if (l_level == g_icp1Level) {
+        g_icp1Settling = 0;
+        return;
+    }
+    if (!SIM_BIT(SIM_ioMemory[SIM_TCCR1B], SIM_TCCR1B_ICNC1)) {
+        g_icp1Settling = 0;
+        SIM_inputCaptureEdge(l_level);
+    } else if (!g_icp1Settling) {
+        g_icp1Settling = 1;
+        g_icp1SettleCycle = SIM_getCycles() + SIM_ICNC1_CYCLES;
+    }
+}
+
+/**
+ * @brief Drives an input pin from outside the chip.
+ *
+ * @param a_port Port index (0 = A ... 3 = D).
+ * @param a_bit Pin number inside the port.
+ * @param a_level Level to drive, 0 or 1.
+ */
+void SIM_setPinInput(uint8_t a_port, uint8_t a_bit, uint8_t a_level) {
+    g_extDriven[a_port] |= (uint8_t) (1 << a_bit);
+    if (a_level) {
+        g_extLevel[a_port] |= (uint8_t) (1 << a_bit);
+    } else {
+        g_extLevel[a_port] &= (uint8_t) ~(1 << a_bit);
+    }
+    SIM_inputCaptureCheck();
+}
+
+/**
+ * @brief Stops driving an input pin; it then follows its pull-up.
+ */
+void SIM_releasePinInput(uint8_t a_port, uint8_t a_bit) {
+    g_extDriven[a_port] &= (uint8_t) ~(1 << a_bit);
+    SIM_inputCaptureCheck();
+}
+
+/**
+ * @brief Sets the analog level of an ADC channel.
+ *
+ * @param a_channel ADC channel, 0 to 7.
+ * @param a_code Level in 10-bit codes; fractions fall between two codes.
+ */
+void SIM_setAdcInput(uint8_t a_channel, double a_code) {
+    g_adcInput[a_channel] = a_code;
+}
+
+/**
+ * @brief Sets the Gaussian noise added to every conversion of an ADC channel.
+ *
+ * @param a_channel ADC channel, 0 to 7.
+ * @param a_rms Standard deviation in codes, 0 for none.
+ */
+void SIM_setAdcNoise(uint8_t a_channel, double a_rms) {
+    g_adcNoise[a_channel] = a_rms;
+}
+
+/**
+ * @brief Sets the Gaussian noise that CPU and I/O activity adds to conversions.
+ *
+ * It applies to every channel, except for conversions that run entirely in ADC
+ * Noise Reduction sleep.
+ *
+ * @param a_rms Standard deviation in codes, 0 for none.
+ */
+void SIM_setAdcCpuNoise(double a_rms) {
+    g_adcCpuNoise = a_rms;
+}
+
+/**
+ * @brief Sets the noise that motor switching adds to conversions sampled just after
+ * an OC0 edge, while the H-bridge drives the fan.
+ *
+ * @param a_rms Standard deviation in codes, 0 for none.
+ * @param a_us How long after an edge the noise lasts, in microseconds.
+ */
+void SIM_setAdcPwmNoise(double a_rms, double a_us) {
+    g_adcPwmNoise = a_rms;
+    g_adcPwmNoiseCycles = (uint64_t) (a_us * ((double) F_CPU / 1000000.0));
+}
+
+/**
+ * @brief Prints the LCD contents and the actuator outputs on one line.
+ */
+void SIM_printSnapshot(void) {
+    uint8_t l_portB = SIM_pinLevels(SIM_PORT_B) & SIM_ioMemory[SIM_DDR_ADDRESS(SIM_PORT_B)];
+    uint8_t l_portD = SIM_pinLevels(SIM_PORT_D) & SIM_ioMemory[SIM_DDR_ADDRESS(SIM_PORT_D)];
+    uint8_t l_in1 = SIM_BIT(l_portB, SIM_MOTOR_IN1);
+    uint8_t l_in2 = SIM_BIT(l_portB, SIM_MOTOR_IN2);
+    const char *l_direction = (l_in1 == l_in2) ? "stop" : (l_in1 ? "cw" : "acw");
+    double l_room;
+    double l_rpm;
+
+    printf("lcd [%.*s|%.*s] led b%u g%u r%u motor %-4s %3u%% buzzer %u",
+            SIM_LCD_COLUMNS, &g_lcdDdram[0x00], SIM_LCD_COLUMNS, &g_lcdDdram[0x40],
+            SIM_BIT(l_portB, 5), SIM_BIT(l_portB, 6), SIM_BIT(l_portB, 7), l_direction,
+            (unsigned) (SIM_fanDrive() * 100.0 + 0.5),
+            SIM_BIT(l_portD, SIM_BUZZER_BIT));
+    if (SIM_plantTemperature(&l_room)) {
+        printf(" room %.2fC", l_room);
+    }
+    if (SIM_fanRpm(&l_rpm)) {
+        printf(" fan %.0frpm", l_rpm);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Returns the fan drive as a fraction, 0 when the H-bridge inputs stop it.
+ */
+double SIM_getFanDuty(void) {
+    uint8_t l_portB = SIM_pinLevels(SIM_PORT_B) & SIM_ioMemory[SIM_DDR_ADDRESS(SIM_PORT_B)];
+
+    if (SIM_BIT(l_portB, SIM_MOTOR_IN1) == SIM_BIT(l_portB, SIM_MOTOR_IN2)) {
+        return 0.0;
+    }
+    return SIM_fanDrive();
+}
+
+/**
+ * @brief Prints the peripheral counters gathered during the run.
+ */
+void SIM_printPeripheralStats(void) {
+    printf("lcd commands   : %u\n", g_lcdCommands);
+    printf("lcd data       : %u\n", g_lcdData);
+    printf("lcd too early  : %u\n", g_lcdTooEarly);
+    printf("lcd reads      : %u\n", g_lcdReads);
+    printf("adc conversions: %u (%u quiet, %u triggered, %u after switching)\n",
+            g_adcConversions, g_adcQuietConversions, g_adcTriggeredConversions,
+            g_adcSwitchingConversions);
+    printf("ocr0 changes   : %u (largest step %u)\n", g_ocr0Changes, g_ocr0MaxStep);
+    if (g_icp1Captures[0] + g_icp1Captures[1] > 0) {
+        printf("icp1 captures  : %u on falling edges, %u on rising edges\n",
+                g_icp1Captures[0], g_icp1Captures[1]);
+    }
+    SIM_printPlantStats();
+    SIM_printFanStats();
+}
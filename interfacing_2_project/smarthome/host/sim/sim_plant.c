@@ -0,0 +1,175 @@
+/**
+ * @file sim_plant.c
+ * @brief First-order thermal model of the room, closed through the LM35 and the fan.
+ *
+ * The room loses heat to the ambient through a fixed conductance, and the fan adds
+ * up to SIM_PLANT_FAN_GAIN times more in proportion to its duty:
+ *
+ *     dT/dt = (rise - (1 + gain * duty) * (T - ambient)) / tau
+ *
+ * so with the fan off the room settles `rise` above the ambient. The temperature is
+ * written to the sensor's ADC channel (4 codes per degree, as for the LM35 on the
+ * 2.56 V reference) whenever that channel is converted. The run summary reports how
+ * long the room took to settle after the last heat change.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Time constant of the room with the fan off, in seconds */
+#define SIM_PLANT_TAU_S         20.0
+/* Extra heat loss at full fan, relative to the loss with the fan off */
+#define SIM_PLANT_FAN_GAIN      4.0
+/* LM35 codes per degree on the 2.56 V reference */
+#define SIM_PLANT_CODES_PER_C   4.0
+/* Longest integration step, in seconds */
+#define SIM_PLANT_STEP_S        0.001
+/* Trace period and the band that counts as settled */
+#define SIM_PLANT_TRACE_MS      10.0
+#define SIM_PLANT_SETTLED_C     0.5
+
+/*******************************************************************************
+ *                                Global Variables                             *
+ *******************************************************************************/
+
+static uint8_t g_plantActive;
+static uint8_t g_plantChannel;
+static double g_plantAmbient;
+static double g_plantRise;
+static double g_plantTemperature;
+static double g_plantLastMs;
+static double g_plantHeatMs;
+
+/* Temperature every SIM_PLANT_TRACE_MS, for the settling time */
+static float *g_plantTrace;
+static size_t g_plantTraceCount;
+static size_t g_plantTraceSize;
+static double g_plantTraceMs;
+
+/*******************************************************************************
+ *                                Functions Definitions                        *
+ *******************************************************************************/
+
+/**
+ * @brief Puts the room model on an ADC channel, starting at the ambient temperature.
+ *
+ * @param a_channel ADC channel of the temperature sensor.
+ * @param a_ambient Ambient temperature in degrees Celsius.
+ */
+void SIM_plantStart(uint8_t a_channel, double a_ambient) {
+    g_plantActive = 1;
+    g_plantChannel = a_channel;
+    g_plantAmbient = a_ambient;
+    g_plantTemperature = a_ambient;
+    g_plantLastMs = SIM_getTimeMs();
+    g_plantTraceMs = g_plantLastMs;
+    g_plantHeatMs = g_plantLastMs;
+    g_plantTraceCount = 0;
+    SIM_setAdcInput(a_channel, g_plantTemperature * SIM_PLANT_CODES_PER_C);
+}
+
+/**
+ * @brief Sets the heat load, as the rise above ambient it gives with the fan off.
+ *
+ * @param a_rise Temperature rise in degrees Celsius.
+ */
+void SIM_plantSetHeat(double a_rise) {
+    SIM_plantUpdate();
+    g_plantRise = a_rise;
+    g_plantHeatMs = SIM_getTimeMs();
+}
+
+/**
+ * @brief Advances the room model to the current time and updates the sensor input.
+ */
+void SIM_plantUpdate(void) {
+    double l_now = SIM_getTimeMs();
+    double l_seconds;
+    double l_duty;
+
+    if (!g_plantActive || l_now <= g_plantLastMs) {
+        return;
+    }
+    l_seconds = (l_now - g_plantLastMs) / 1000.0;
+    l_duty = SIM_getFanDuty();
+    while (l_seconds > 0) {
+        double l_step = (l_seconds < SIM_PLANT_STEP_S) ? l_seconds : SIM_PLANT_STEP_S;
+        double l_excess = g_plantTemperature - g_plantAmbient;
+
+        g_plantTemperature += l_step * (g_plantRise - (1.0 + SIM_PLANT_FAN_GAIN * l_duty) * l_excess)
+                / SIM_PLANT_TAU_S;
+        l_seconds -= l_step;
+    }
+    g_plantLastMs = l_now;
+
+    while (g_plantTraceMs <= l_now) {
+        if (g_plantTraceCount == g_plantTraceSize) {
+            g_plantTraceSize = g_plantTraceSize ? 2 * g_plantTraceSize : 1024;
+            g_plantTrace = realloc(g_plantTrace, g_plantTraceSize * sizeof(float));
+            if (g_plantTrace == NULL) {
+                fprintf(stderr, "plant: out of memory\n");
+                exit(2);
+            }
+        }
+        g_plantTrace[g_plantTraceCount++] = (float) g_plantTemperature;
+        g_plantTraceMs += SIM_PLANT_TRACE_MS;
+    }
+    SIM_setAdcInput(g_plantChannel, g_plantTemperature * SIM_PLANT_CODES_PER_C);
+}
+
+/**
+ * @brief Gives the room temperature; returns 0 if the model is not running.
+ */
+int SIM_plantTemperature(double *a_temperature) {
+    *a_temperature = g_plantTemperature;
+    return g_plantActive;
+}
+
+/**
+ * @brief Prints the final temperature and the settling time after the last heat change.
+ *
+ * Settled means staying within SIM_PLANT_SETTLED_C of the final temperature.
+ */
+void SIM_printPlantStats(void) {
+    size_t l_first;
+    size_t i;
+    double l_final;
+    double l_min;
+    double l_max;
+    double l_settledMs;
+
+    if (!g_plantActive) {
+        return;
+    }
+    SIM_plantUpdate();
+    l_final = g_plantTemperature;
+    l_first = (size_t) ((g_plantHeatMs - (g_plantTraceMs - SIM_PLANT_TRACE_MS * g_plantTraceCount))
+            / SIM_PLANT_TRACE_MS);
+    if (l_first > g_plantTraceCount) {
+        l_first = g_plantTraceCount;
+    }
+    l_min = l_max = l_final;
+    l_settledMs = 0;
+    for (i = l_first; i < g_plantTraceCount; i++) {
+        double l_temperature = g_plantTrace[i];
+
+        l_min = fmin(l_min, l_temperature);
+        l_max = fmax(l_max, l_temperature);
+        if (fabs(l_temperature - l_final) > SIM_PLANT_SETTLED_C) {
+            l_settledMs = (double) (i + 1 - l_first) * SIM_PLANT_TRACE_MS;
+        }
+    }
+    printf("plant final    : %.2f C (range %.2f to %.2f since the last heat change)\n",
+            l_final, l_min, l_max);
+    printf("plant settled  : %.0f ms after the last heat change (within %.1f C)\n",
+            l_settledMs, SIM_PLANT_SETTLED_C);
+}
@@ -0,0 +1,300 @@
+/**
+ * @file sim_scenario.c
+ * @brief Scripted inputs for the simulated ATmega32.
+ *
+ * A scenario is a text file with one event per line:
+ *
+ *     <time_ms> adc <channel> <code>      drive an ADC input with a 10-bit code (may have a fraction)
+ *     <time_ms> noise <channel> <rms>     add Gaussian noise of <rms> codes to its conversions
+ *     <time_ms> cpunoise <rms>            noise of <rms> codes from CPU activity, on every
+ *                                         conversion not run in ADC Noise Reduction sleep
+ *     <time_ms> pwmnoise <rms> <us>       noise of <rms> codes on conversions sampled within
+ *                                         <us> of a fan PWM edge
+ *     <time_ms> plant <channel> <C>       model the room on an LM35 channel, from <C> ambient
+ *     <time_ms> heat <rise C>             heat load: the room settles <rise> above ambient, fan off
+ *     <time_ms> fan <max rpm> <pulses>    connect a fan with a tach output on PD6, <pulses> per turn
+ *     <time_ms> fanload <load>            fan load: 1 clean, below 1 slowed (dust), 0 blocked
+ *     <time_ms> tachspikes <cycles>       while the fan is driven, pull its tach line low for
+ *                                         <cycles> every fan PWM period (0 stops them)
+ *     <time_ms> pin <A-D> <bit> <0|1>     drive an input pin from outside
+ *     <time_ms> release <A-D> <bit>       stop driving a pin (pull-up or 0 remains)
+ *     <time_ms> print                     print the LCD and actuator state
+ *     <time_ms> end                       print the summary and stop
+ *
+ * Text after `#` is a comment. Events must be in time order.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/**
+ * @brief Simulated run length when no scenario file is given, in milliseconds.
+ */
+#define SIM_DEFAULT_RUN_MS 1000
+
+/**
+ * @brief Maximum length of a scenario line.
+ */
+#define SIM_SCENARIO_LINE_LENGTH 128
+
+typedef enum {
+    SIM_EVENT_ADC,
+    SIM_EVENT_NOISE,
+    SIM_EVENT_CPU_NOISE,
+    SIM_EVENT_PWM_NOISE,
+    SIM_EVENT_PLANT,
+    SIM_EVENT_HEAT,
+    SIM_EVENT_FAN,
+    SIM_EVENT_FAN_LOAD,
+    SIM_EVENT_TACH_SPIKES,
+    SIM_EVENT_PIN,
+    SIM_EVENT_RELEASE,
+    SIM_EVENT_PRINT,
+    SIM_EVENT_END
+} SIM_EventType;
+
+typedef struct {
+    uint64_t cycle;
+    SIM_EventType type;
+    uint8_t port;
+    uint8_t index;
+    uint16_t value;
+    double analog;
+} SIM_Event;
+
+static SIM_Event *g_events = NULL;
+static size_t g_eventCount = 0;
+static size_t g_nextEvent = 0;
+
+/**
+ * @brief Converts a time in milliseconds to CPU cycles.
+ */
+static uint64_t SIM_msToCycles(double a_ms) {
+    return (uint64_t) (a_ms * ((double) F_CPU / 1000.0) + 0.5);
+}
+
+/**
+ * @brief Appends an event to the list.
+ */
+static void SIM_addEvent(const SIM_Event *a_event) {
+    g_events = realloc(g_events, (g_eventCount + 1) * sizeof(SIM_Event));
+    if (g_events == NULL) {
+        fprintf(stderr, "scenario: out of memory\n");
+        exit(2);
+    }
+    g_events[g_eventCount++] = *a_event;
+}
+
+/**
+ * @brief Parses a port letter (A-D) into a port index.
+ */
+static int SIM_parsePort(const char *a_text) {
+    int l_letter = toupper((unsigned char) a_text[0]);
+    return (l_letter >= 'A' && l_letter <= 'D' && a_text[1] == '\0') ? l_letter - 'A' : -1;
+}
+
+/**
+ * @brief Parses one scenario line; returns 0 on success.
+ */
+static int SIM_parseLine(char *a_line, SIM_Event *a_event) {
+    char l_command[16], l_arg1[16];
+    double l_ms, l_number = 0;
+    int l_arg2 = 0, l_arg3 = 0, l_fields;
+
+    l_fields = sscanf(a_line, "%lf %15s %15s %lf %d", &l_ms, l_command, l_arg1, &l_number,
+            &l_arg3);
+    if (l_fields < 2 || l_ms < 0) {
+        return -1;
+    }
+    l_arg2 = (int) l_number;
+    memset(a_event, 0, sizeof(*a_event));
+    a_event->cycle = SIM_msToCycles(l_ms);
+
+    if ((strcmp(l_command, "adc") == 0 || strcmp(l_command, "noise") == 0) && l_fields == 4) {
+        a_event->type = (l_command[0] == 'a') ? SIM_EVENT_ADC : SIM_EVENT_NOISE;
+        a_event->index = (uint8_t) atoi(l_arg1);
+        a_event->analog = l_number;
+        return (a_event->index < SIM_ADC_CHANNELS && l_number >= 0 && l_number <= 1023) ? 0 : -1;
+    }
+    if (strcmp(l_command, "cpunoise") == 0 && l_fields == 3) {
+        a_event->type = SIM_EVENT_CPU_NOISE;
+        a_event->analog = atof(l_arg1);
+        return (a_event->analog >= 0) ? 0 : -1;
+    }
+    if (strcmp(l_command, "pwmnoise") == 0 && l_fields == 4) {
+        a_event->type = SIM_EVENT_PWM_NOISE;
+        a_event->analog = atof(l_arg1);
+        a_event->value = (uint16_t) l_number;
+        return (a_event->analog >= 0 && l_number >= 0 && l_number <= 128) ? 0 : -1;
+    }
+    if (strcmp(l_command, "plant") == 0 && l_fields == 4) {
+        a_event->type = SIM_EVENT_PLANT;
+        a_event->index = (uint8_t) atoi(l_arg1);
+        a_event->analog = l_number;
+        return (a_event->index < SIM_ADC_CHANNELS) ? 0 : -1;
+    }
+    if (strcmp(l_command, "heat") == 0 && l_fields == 3) {
+        a_event->type = SIM_EVENT_HEAT;
+        a_event->analog = atof(l_arg1);
+        return 0;
+    }
+    if (strcmp(l_command, "fan") == 0 && l_fields == 4) {
+        a_event->type = SIM_EVENT_FAN;
+        a_event->analog = atof(l_arg1);
+        a_event->value = (uint16_t) l_number;
+        return (a_event->analog > 0 && l_number >= 1 && l_number <= 8) ? 0 : -1;
+    }
+    if (strcmp(l_command, "fanload") == 0 && l_fields == 3) {
+        a_event->type = SIM_EVENT_FAN_LOAD;
+        a_event->analog = atof(l_arg1);
+        return (a_event->analog >= 0) ? 0 : -1;
+    }
+    if (strcmp(l_command, "tachspikes") == 0 && l_fields == 3) {
+        a_event->type = SIM_EVENT_TACH_SPIKES;
+        a_event->value = (uint16_t) atoi(l_arg1);
+        return (atoi(l_arg1) >= 0) ? 0 : -1;
+    }
+    if ((strcmp(l_command, "pin") == 0 && l_fields == 5)
+            || (strcmp(l_command, "release") == 0 && l_fields == 4)) {
+        int l_port = SIM_parsePort(l_arg1);
+        a_event->type = (l_command[0] == 'p') ? SIM_EVENT_PIN : SIM_EVENT_RELEASE;
+        a_event->port = (uint8_t) l_port;
+        a_event->index = (uint8_t) l_arg2;
+        a_event->value = (uint16_t) (l_arg3 != 0);
+        return (l_port >= 0 && l_arg2 >= 0 && l_arg2 < 8) ? 0 : -1;
+    }
+    if (strcmp(l_command, "print") == 0 && l_fields == 2) {
+        a_event->type = SIM_EVENT_PRINT;
+        return 0;
+    }
+    if (strcmp(l_command, "end") == 0 && l_fields == 2) {
+        a_event->type = SIM_EVENT_END;
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Loads a scenario file; a NULL path only schedules the default end.
+ *
+ * @param a_path Path of the scenario file, or NULL.
+ */
+void SIM_scenarioLoad(const char *a_path) {
+    char l_line[SIM_SCENARIO_LINE_LENGTH];
+    unsigned int l_lineNumber = 0;
+    SIM_Event l_event;
+    FILE *l_file;
+    uint8_t l_hasEnd = 0;
+
+    if (a_path != NULL) {
+        l_file = fopen(a_path, "r");
+        if (l_file == NULL) {
+            fprintf(stderr, "scenario: cannot open %s\n", a_path);
+            exit(2);
+        }
+        while (fgets(l_line, sizeof(l_line), l_file) != NULL) {
+            char *l_comment = strchr(l_line, '#');
+            char *l_text = l_line;
+
+            l_lineNumber++;
+            if (l_comment != NULL) {
+                *l_comment = '\0';
+            }
+            while (isspace((unsigned char) *l_text)) {
+                l_text++;
+            }
+            if (*l_text == '\0') {
+                continue;
+            }
+            if (SIM_parseLine(l_text, &l_event) != 0) {
+                fprintf(stderr, "scenario: %s:%u: cannot parse \"%s\"\n", a_path,
+                        l_lineNumber, l_text);
+                exit(2);
+            }
+            if (g_eventCount && l_event.cycle < g_events[g_eventCount - 1].cycle) {
+                fprintf(stderr, "scenario: %s:%u: events out of time order\n", a_path,
+                        l_lineNumber);
+                exit(2);
+            }
+            l_hasEnd |= (l_event.type == SIM_EVENT_END);
+            SIM_addEvent(&l_event);
+        }
+        fclose(l_file);
+    }
+
+    if (!l_hasEnd) {
+        memset(&l_event, 0, sizeof(l_event));
+        l_event.type = SIM_EVENT_END;
+        l_event.cycle = g_eventCount ? g_events[g_eventCount - 1].cycle + SIM_msToCycles(SIM_DEFAULT_RUN_MS)
+                : SIM_msToCycles(SIM_DEFAULT_RUN_MS);
+        SIM_addEvent(&l_event);
+    }
+    g_nextEvent = 0;
+}
+
+/**
+ * @brief Applies every event that is due at the current cycle.
+ */
+void SIM_scenarioPoll(void) {
+    uint64_t l_now = SIM_getCycles();
+
+    while (g_nextEvent < g_eventCount && g_events[g_nextEvent].cycle <= l_now) {
+        const SIM_Event *l_event = &g_events[g_nextEvent++];
+
+        switch (l_event->type) {
+        case SIM_EVENT_ADC:
+            SIM_setAdcInput(l_event->index, l_event->analog);
+            break;
+        case SIM_EVENT_NOISE:
+            SIM_setAdcNoise(l_event->index, l_event->analog);
+            break;
+        case SIM_EVENT_CPU_NOISE:
+            SIM_setAdcCpuNoise(l_event->analog);
+            break;
+        case SIM_EVENT_PWM_NOISE:
+            SIM_setAdcPwmNoise(l_event->analog, l_event->value);
+            break;
+        case SIM_EVENT_PLANT:
+            SIM_plantStart(l_event->index, l_event->analog);
+            break;
+        case SIM_EVENT_HEAT:
+            SIM_plantSetHeat(l_event->analog);
+            break;
+        case SIM_EVENT_FAN:
+            SIM_fanStart(l_event->analog, (uint8_t) l_event->value);
+            break;
+        case SIM_EVENT_FAN_LOAD:
+            SIM_fanSetLoad(l_event->analog);
+            break;
+        case SIM_EVENT_TACH_SPIKES:
+            SIM_fanSetSpikes(l_event->value);
+            break;
+        case SIM_EVENT_PIN:
+            SIM_setPinInput(l_event->port, l_event->index, (uint8_t) l_event->value);
+            break;
+        case SIM_EVENT_RELEASE:
+            SIM_releasePinInput(l_event->port, l_event->index);
+            break;
+        case SIM_EVENT_PRINT:
+            SIM_peripheralsSample();
+            SIM_printSnapshot();
+            break;
+        case SIM_EVENT_END:
+            SIM_finish();
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Returns the cycle of the next scenario event.
+ */
+uint64_t SIM_scenarioNextEventCycle(void) {
+    return (g_nextEvent < g_eventCount) ? g_events[g_nextEvent].cycle : UINT64_MAX;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file test.h
+ * @brief Minimal check macro shared by the host tests.
+ *
+ * Each test is a plain program: it counts the failed checks, prints the first
+ * few and exits with status 1 if any failed, which stops `make test`.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+
+/* Failures printed in full before the rest are only counted */
+#define TEST_MAX_REPORTS 10
+
+static unsigned g_testChecks;
+static unsigned g_testFailures;
+
+/**
+ * @brief Records one check; on failure prints the location and the message.
+ */
+#define TEST_CHECK(condition, ...) do { \
+		g_testChecks++; \
+		if (!(condition)) { \
+			if (g_testFailures++ < TEST_MAX_REPORTS) { \
+				printf("%s:%d: ", __FILE__, __LINE__); \
+				printf(__VA_ARGS__); \
+				printf("\n"); \
+			} \
+		} \
+	} while (0)
+
+/**
+ * @brief Prints the summary line and gives the exit status of the test.
+ */
+#define TEST_RESULT(name) \
+	(printf("%-12s: %u checks, %u failed\n", (name), g_testChecks, g_testFailures), \
+	 g_testFailures ? 1 : 0)
+
+#endif /* TEST_H_ */
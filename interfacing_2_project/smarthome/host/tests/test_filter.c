@@ -0,0 +1,165 @@
+/**
+ * @file test_filter.c
+ * @brief Checks the streaming filters of common/filter.c against brute force.
+ *
+ * Random sample streams go through each filter and through a plain reference
+ * that keeps the whole window: a sort for the median, a sum for the average and
+ * a double-precision recurrence for the exponential average.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "test.h"
+#include "../../common/filter.h"
+
+/* Samples fed to each filter configuration */
+#define STREAM_LENGTH 20000
+
+/* Widest samples: the average sums 8 of 13 bits, the EMA keeps 16 - shift bits */
+#define SAMPLE_BITS 12
+#define SAMPLE_MASK ((1u << SAMPLE_BITS) - 1)
+
+/* Longest EMA shift tried, keeping SAMPLE_BITS + shift within 16 bits */
+#define EMA_MAX_SHIFT 4
+
+static unsigned long g_random = 1;
+
+/**
+ * @brief Pseudo-random sample: mostly small steps, with the odd jump across the
+ * whole range, so both the settling and the outlier handling get exercised.
+ */
+static uint16 nextSample(uint16 a_previous)
+{
+	long l_sample;
+
+	g_random = g_random * 1103515245UL + 12345UL;
+	if (((g_random >> 16) & 0x1F) == 0)
+		return (g_random >> 8) & SAMPLE_MASK;
+	l_sample = (long) a_previous + (long) ((g_random >> 16) & 0x3F) - 32;
+	if (l_sample < 0)
+		l_sample = 0;
+	if (l_sample > (long) SAMPLE_MASK)
+		l_sample = SAMPLE_MASK;
+	return (uint16) l_sample;
+}
+
+static int compareSamples(const void *a_left, const void *a_right)
+{
+	return (int) *(const uint16 *) a_left - (int) *(const uint16 *) a_right;
+}
+
+static void testMedian(uint8 a_length)
+{
+	FILTER_MEDIAN l_filter;
+	uint16 l_window[FILTER_MEDIAN_MAX_LENGTH];
+	uint16 l_sorted[FILTER_MEDIAN_MAX_LENGTH];
+	uint16 l_sample = SAMPLE_MASK / 2;
+	unsigned l_n;
+	uint8 i;
+
+	Filter_medianInit(&l_filter, a_length);
+	for (l_n = 0; l_n < STREAM_LENGTH; l_n++) {
+		uint16 l_output;
+
+		l_sample = nextSample(l_sample);
+		l_output = Filter_medianUpdate(&l_filter, l_sample);
+
+		/* The first sample fills the window */
+		for (i = 0; i < a_length; i++) {
+			if (l_n == 0)
+				l_window[i] = l_sample;
+			else if (i + 1 < a_length)
+				l_window[i] = l_window[i + 1];
+			else
+				l_window[i] = l_sample;
+		}
+		for (i = 0; i < a_length; i++)
+			l_sorted[i] = l_window[i];
+		qsort(l_sorted, a_length, sizeof(l_sorted[0]), compareSamples);
+
+		TEST_CHECK(l_output == l_sorted[a_length / 2],
+				"median %u, sample %u: %u, expected %u", a_length, l_n, l_output,
+				l_sorted[a_length / 2]);
+	}
+}
+
+static void testAverage(uint8 a_lengthBits)
+{
+	FILTER_AVERAGE l_filter;
+	uint16 l_window[FILTER_AVERAGE_MAX_LENGTH];
+	uint8 l_length = 1 << a_lengthBits;
+	uint16 l_sample = SAMPLE_MASK / 2;
+	unsigned l_n;
+	uint8 i;
+
+	Filter_averageInit(&l_filter, a_lengthBits);
+	for (l_n = 0; l_n < STREAM_LENGTH; l_n++) {
+		uint16 l_output;
+		unsigned long l_sum = 0;
+		unsigned l_expected;
+
+		l_sample = nextSample(l_sample);
+		l_output = Filter_averageUpdate(&l_filter, l_sample);
+
+		for (i = 0; i < l_length; i++) {
+			if (l_n == 0 || i + 1 == l_length)
+				l_window[i] = l_sample;
+			else
+				l_window[i] = l_window[i + 1];
+			l_sum += l_window[i];
+		}
+		/* Mean rounded half up */
+		l_expected = (unsigned) ((l_sum + l_length / 2) / l_length);
+
+		TEST_CHECK(l_output == l_expected, "average of %u, sample %u: %u, expected %u",
+				l_length, l_n, l_output, l_expected);
+	}
+}
+
+static void testEma(uint8 a_shift)
+{
+	FILTER_EMA l_filter;
+	uint16 l_sample = SAMPLE_MASK / 2;
+	double l_exact = 0;
+	unsigned l_n;
+	uint16 l_output = 0;
+
+	Filter_emaInit(&l_filter, a_shift);
+	for (l_n = 0; l_n < STREAM_LENGTH; l_n++) {
+		l_sample = nextSample(l_sample);
+		l_output = Filter_emaUpdate(&l_filter, l_sample);
+		if (l_n == 0)
+			l_exact = l_sample;
+		else
+			l_exact += (l_sample - l_exact) / (1 << a_shift);
+
+		/* Half a code of state rounding plus half a code of output rounding */
+		TEST_CHECK(fabs(l_output - l_exact) <= 1.0,
+				"ema shift %u, sample %u: %u, exact %.3f", a_shift, l_n, l_output, l_exact);
+	}
+
+	/* A constant input must be reached exactly, from above and from below */
+	for (l_n = 0; l_n < 40 << a_shift; l_n++)
+		l_output = Filter_emaUpdate(&l_filter, SAMPLE_MASK);
+	TEST_CHECK(l_output == SAMPLE_MASK, "ema shift %u settles at %u rising", a_shift, l_output);
+	for (l_n = 0; l_n < 40 << a_shift; l_n++)
+		l_output = Filter_emaUpdate(&l_filter, 1);
+	TEST_CHECK(l_output == 1, "ema shift %u settles at %u falling", a_shift, l_output);
+}
+
+int main(void)
+{
+	uint8 l_parameter;
+
+	testMedian(3);
+	testMedian(5);
+	for (l_parameter = 0; l_parameter <= FILTER_AVERAGE_MAX_BITS; l_parameter++)
+		testAverage(l_parameter);
+	for (l_parameter = 1; l_parameter <= EMA_MAX_SHIFT; l_parameter++)
+		testEma(l_parameter);
+
+	return TEST_RESULT("filter");
+}
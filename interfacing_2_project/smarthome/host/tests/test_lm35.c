@@ -0,0 +1,79 @@
+/**
+ * @file test_lm35.c
+ * @brief Checks the LM35 fixed-point conversion and degrees table on every code.
+ *
+ * The reference is the double-precision formula the driver used before it went
+ * to integer arithmetic: adc * 150 * 2.56 / (1023 * 1.5).
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include <math.h>
+#include "test.h"
+#include "../../hal/lm35_sensor.h"
+#include "../../hal/sensor_tables.h"
+#include "../../mcal/adc.h"
+
+/* Full scale of the oversampled reading */
+#define OVERSAMPLED_FULL_SCALE ((unsigned) ADC_MAXIMUM_VALUE << SENSOR_OVERSAMPLING_BITS)
+
+/*
+ * Slack for the double result of an exact division, e.g. 1023 * 2.56 * 150 /
+ * (1023 * 1.5) comes out a hair under 256.
+ */
+#define DOUBLE_SLACK 1e-9
+
+/* The ADC reads of lm35_sensor.c, unused by the conversion under test */
+uint8 ADC_getRoundCount(void)
+{
+	return 0;
+}
+
+uint16 ADC_getLatestSampleHighRes(uint8 a_channel, uint8 a_extraBits)
+{
+	(void) a_channel;
+	(void) a_extraBits;
+	return 0;
+}
+
+/**
+ * @brief Degrees Celsius for an oversampled reading, in double precision.
+ */
+static double lm35Degrees(unsigned a_sample)
+{
+	return a_sample * SENSOR_MAX_TEMPERATURE * ADC_REF_VOLT_VALUE
+			/ (OVERSAMPLED_FULL_SCALE * SENSOR_MAX_VOLT_VALUE);
+}
+
+int main(void)
+{
+	unsigned l_code;
+	unsigned l_sample;
+
+	/* Every 10-bit code: tenths and the table must equal the truncated formula */
+	for (l_code = 0; l_code <= ADC_MAXIMUM_VALUE; l_code++) {
+		double l_degrees = lm35Degrees(l_code << SENSOR_OVERSAMPLING_BITS);
+		unsigned l_tenths = LM35_convertTenths(l_code << SENSOR_OVERSAMPLING_BITS);
+		unsigned l_expectedDegrees = (unsigned) floor(l_degrees + DOUBLE_SLACK);
+		unsigned l_table = pgm_read_byte(&g_lm35DegreesTable[l_code]);
+
+		TEST_CHECK(l_tenths == (unsigned) floor(l_degrees * 10 + DOUBLE_SLACK),
+				"code %u: %u tenths, formula %.6f", l_code, l_tenths, l_degrees * 10);
+		if (l_expectedDegrees > 255)
+			l_expectedDegrees = 255;
+		TEST_CHECK(l_table == l_expectedDegrees,
+				"code %u: table %u C, formula %.6f", l_code, l_table, l_degrees);
+	}
+
+	/* Every oversampled reading, with the same truncation */
+	for (l_sample = 0; l_sample <= OVERSAMPLED_FULL_SCALE; l_sample++) {
+		double l_exact = lm35Degrees(l_sample) * 10;
+		unsigned l_tenths = LM35_convertTenths(l_sample);
+
+		TEST_CHECK(l_tenths == (unsigned) floor(l_exact + DOUBLE_SLACK),
+				"sample %u: %u tenths, formula %.6f", l_sample, l_tenths, l_exact);
+	}
+
+	return TEST_RESULT("lm35");
+}
@@ -0,0 +1,70 @@
+/**
+ * @file test_timer1.c
+ * @brief Checks the TCCR1B bits that Timer1_setCaptureEdge() writes.
+ *
+ * The driver runs against a bare register file, so the bit positions are checked
+ * against the datasheet (ICES1 = bit 6, ICNC1 = bit 7, bit 5 reserved) rather
+ * than against the simulator, which decodes the same layout.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include "test.h"
+#include "../../mcal/timer_1.h"
+#include <avr/io.h>
+
+#define TCCR1B_ADDRESS 0x4E
+#define SREG_ADDRESS   0x5F
+#define ICES1_BIT      6
+#define ICNC1_BIT      7
+
+/* Register file of the driver under test, in place of the simulator */
+volatile uint8_t SIM_ioMemory[0x60];
+
+volatile uint8_t *SIM_accessRegister(uint8_t a_address)
+{
+	return &SIM_ioMemory[a_address];
+}
+
+const volatile uint8_t *SIM_readFlags(uint8_t a_address)
+{
+	return &SIM_ioMemory[a_address];
+}
+
+void SIM_sei(void)
+{
+	SIM_ioMemory[SREG_ADDRESS] |= (1 << SREG_I);
+}
+
+void SIM_cli(void)
+{
+	SIM_ioMemory[SREG_ADDRESS] &= ~(1 << SREG_I);
+}
+
+int main(void)
+{
+	/* Prescaler 8 and the reserved bit 5 set, to see that neither is touched */
+	const uint8_t l_other = (1 << 5) | 0x02;
+	unsigned l_edge;
+	unsigned l_canceler;
+
+	for (l_edge = 0; l_edge < 2; l_edge++) {
+		for (l_canceler = 0; l_canceler < 2; l_canceler++) {
+			uint8_t l_expected = l_other
+					| ((l_edge == TIMER1_CAPTURE_RISING) << ICES1_BIT)
+					| (l_canceler << ICNC1_BIT);
+
+			SIM_ioMemory[TCCR1B_ADDRESS] = (uint8_t) (l_other | (1 << ICES1_BIT) | (1 << ICNC1_BIT));
+			SIM_ioMemory[SREG_ADDRESS] = (1 << SREG_I);
+			Timer1_setCaptureEdge((Timer1_CaptureEdge) l_edge, (boolean) l_canceler);
+			TEST_CHECK(SIM_ioMemory[TCCR1B_ADDRESS] == l_expected,
+					"%s edge, canceler %u: TCCR1B 0x%02X, expected 0x%02X",
+					l_edge ? "rising" : "falling", l_canceler,
+					SIM_ioMemory[TCCR1B_ADDRESS], l_expected);
+			TEST_CHECK(SIM_ioMemory[SREG_ADDRESS] == (1 << SREG_I), "SREG not restored");
+		}
+	}
+
+	return TEST_RESULT("timer1");
+}
@@ -1,10 +1,135 @@
 #include "adc.h"
 #include "../mcal/atmega32_regs.h"
 #include "../common/common_macros.h"
+#include "power.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/**
+ * @brief Marks a channel that is not part of the scan list.
+ */
+#define ADC_SCAN_NO_SLOT 0xFF
+
+/**
+ * @brief Auto-trigger sources (ADTS2:0 in SFIOR) from Timer 0, and their flags in TIFR.
+ */
+#define ADC_TRIGGER_TIMER0_COMPARE  3
+#define ADC_TRIGGER_TIMER0_OVERFLOW 4
+#define ADC_TOV0_BIT 0
+#define ADC_OCF0_BIT 1
+
+/**
+ * @brief ADMUX bits of a profile (REFS1:0 at bit 6, ADLAR at bit 5), and the
+ * ADCSRA bits the prescaler update keeps (ADEN, ADSC, ADATE, ADIE; ADIF is
+ * written as zero so a pending result is not cleared).
+ */
+#define ADC_REFS_SHIFT      6
+#define ADC_ADLAR_BIT       5
+#define ADC_ADCSRA_KEEP     0xE8
+#define ADC_ADATE_BIT       5
+#define ADC_PRESCALER_MASK  0x07
+
+/**
+ * @brief Added to an 8-bit result shifted to 10 bits: the middle of its four codes.
+ */
+#define ADC_EIGHT_BIT_HALF_STEP 2
+
+/* Scan list and the slot of each channel inside it */
+static uint8 g_adcScanChannels[ADC_SCAN_MAX_CHANNELS];
+static uint8 g_adcChannelSlot[ADC_SCAN_MAX_CHANNELS] = { ADC_SCAN_NO_SLOT,
+	ADC_SCAN_NO_SLOT, ADC_SCAN_NO_SLOT, ADC_SCAN_NO_SLOT, ADC_SCAN_NO_SLOT,
+	ADC_SCAN_NO_SLOT, ADC_SCAN_NO_SLOT, ADC_SCAN_NO_SLOT };
+static volatile uint8 g_adcScanCount = 0;
+static volatile uint8 g_adcScanIndex = 0;
+
+/* Oversampling bits asked per channel, and the copy taken per slot by the scan */
+static uint8 g_adcChannelBits[ADC_SCAN_MAX_CHANNELS];
+static uint8 g_adcSlotBits[ADC_SCAN_MAX_CHANNELS];
+/* Sum of the current slot and the conversions still to take for it */
+static volatile uint16 g_adcAccumulator = 0;
+static volatile uint8 g_adcSamplesLeft = 0;
+
+/* Double buffer: the ISR fills one half while readers use the published one */
+static volatile uint16 g_adcScanBuffer[2][ADC_SCAN_MAX_CHANNELS];
+static volatile uint8 g_adcPublishedBuffer = 0;
+static volatile uint8 g_adcRoundCount = 0;
+
+/* Blocking reads through ADC Noise Reduction sleep, and the result the ISR hands over */
+static boolean g_adcQuietMode = FALSE;
+static volatile boolean g_adcQuietDone = FALSE;
+static volatile uint16 g_adcQuietResult = 0;
+
+/* Channel profiles: the whole ADMUX byte and the ADPS bits for each channel */
+static uint8 g_adcProfileMux[ADC_SCAN_MAX_CHANNELS];
+static uint8 g_adcProfilePrescaler[ADC_SCAN_MAX_CHANNELS];
+static boolean g_adcProfileEightBit[ADC_SCAN_MAX_CHANNELS];
+static boolean g_adcProfileDiscard[ADC_SCAN_MAX_CHANNELS];
+/* Channel the multiplexer is on, and whether the scan throws its next result away */
+static volatile uint8 g_adcSelected = 0;
+static volatile boolean g_adcScanDiscard = FALSE;
+
+/**
+ * @brief Points the multiplexer at a channel and applies its profile.
+ *
+ * Call it with no conversion running, or from the ADC interrupt.
+ *
+ * @return TRUE if the next conversion has to be thrown away: the profile asks for
+ *         it and the channel or its reference has changed. Auto-triggered
+ *         conversions only start at the next trigger event, which leaves the input
+ *         the idle time of the trigger period to settle, so none is thrown away.
+ */
+static boolean ADC_selectChannel(uint8 a_channel) {
+	uint8 l_mux = g_adcProfileMux[a_channel];
+	uint8 l_adcsra = ADCSRA_REG.byte;
+	boolean l_switched = (ADMUX_REG.byte != l_mux);
+
+	ADMUX_REG.byte = l_mux;
+	ADCSRA_REG.byte = (l_adcsra & ADC_ADCSRA_KEEP) | g_adcProfilePrescaler[a_channel];
+	g_adcSelected = a_channel;
+	return l_switched && g_adcProfileDiscard[a_channel] && !GET_BIT(l_adcsra, ADC_ADATE_BIT);
+}
+
+/**
+ * @brief Returns the last result, on the 10-bit scale whatever the channel profile.
+ */
+static uint16 ADC_readResult(void) {
+	if (g_adcProfileEightBit[g_adcSelected])
+		return ((uint16) ADC_REG.bytes.adch << 2) | ADC_EIGHT_BIT_HALF_STEP;
+	return ADC_REG.value;
+}
+
+/**
+ * @brief Clears the flag of the Timer 0 event selected as auto-trigger source.
+ *
+ * The event only starts a conversion when its flag goes from zero to one, and
+ * with its interrupt disabled nothing else clears it.
+ */
+static void ADC_armTrigger(void) {
+	uint8 l_source = (SFIOR_REG.byte >> 5) & 0x07;
+
+	if (l_source == ADC_TRIGGER_TIMER0_OVERFLOW)
+		TIFR_REG.byte = (1 << ADC_TOV0_BIT);
+	else if (l_source == ADC_TRIGGER_TIMER0_COMPARE)
+		TIFR_REG.byte = (1 << ADC_OCF0_BIT);
+}
+
+/**
+ * @brief Starts a conversion on the selected channel now, or with auto-triggering
+ * at the next trigger event.
+ */
+static void ADC_startConversion(void) {
+	if (ADCSRA_REG.bits.adate == LOGIC_HIGH)
+		ADC_armTrigger();
+	else
+		ADCSRA_REG.bits.adsc = LOGIC_HIGH;
+}
+
 /**
  * @brief Initializes the ADC with internal 2.56V reference and prescaler of F_CPU/128.
  */
 void ADC_init(void) {
+	uint8 i;
+
 	ADMUX_REG.byte=0;
     ADMUX_REG.bits.refs0 = 1;
     ADMUX_REG.bits.refs1 = 1;
@@ -19,6 +144,81 @@ void ADC_init(void) {
 
     // 3. Enable the ADC (ADEN bit in ADCSRA)
 
+    /* The same settings as the profile of every channel */
+    for (i = 0; i < ADC_SCAN_MAX_CHANNELS; i++) {
+        g_adcProfileMux[i] = ADMUX_REG.byte | i;
+        g_adcProfilePrescaler[i] = ADCSRA_REG.byte & ADC_PRESCALER_MASK;
+        g_adcProfileEightBit[i] = FALSE;
+        g_adcProfileDiscard[i] = FALSE;
+    }
+}
+
+/**
+ * @brief Sets the profile of a channel.
+ *
+ * @param a_channel The ADC channel number (0-7).
+ * @param a_profile The settings, copied.
+ */
+void ADC_setChannelProfile(uint8 a_channel, const ADC_ChannelProfile *a_profile) {
+	a_channel &= 0x07;
+	g_adcProfileMux[a_channel] = (uint8) ((a_profile->reference << ADC_REFS_SHIFT)
+			| ((a_profile->eightBit ? 1 : 0) << ADC_ADLAR_BIT) | a_channel);
+	g_adcProfilePrescaler[a_channel] = a_profile->prescaler & ADC_PRESCALER_MASK;
+	g_adcProfileEightBit[a_channel] = a_profile->eightBit;
+	g_adcProfileDiscard[a_channel] = a_profile->discardFirst;
+}
+
+/**
+ * @brief Runs one blocking conversion on the selected channel.
+ *
+ * @return The result on the 10-bit scale.
+ */
+static uint16 ADC_convert(void) {
+	if (ADCSRA_REG.bits.adate == LOGIC_HIGH) {
+		/* Convert at the next trigger event; a conversion an earlier event started
+		 * is waited out and its result dropped */
+		ADC_armTrigger();
+		while (ADCSRA_REG.bits.adsc == LOGIC_HIGH)
+			;
+		ADCSRA_REG.bits.adif = LOGIC_HIGH;
+	} else {
+		ADCSRA_REG.bits.adsc=LOGIC_HIGH;
+	}
+
+		while (ADCSRA_REG.bits.adif == LOGIC_LOW)
+			;
+		ADCSRA_REG.bits.adif = LOGIC_HIGH;
+		g_adcRoundCount++;
+		return ADC_readResult();
+}
+
+/**
+ * @brief Runs one conversion on the selected channel in ADC Noise Reduction sleep.
+ *
+ * Any other interrupt that wakes the CPU first is serviced and the CPU goes back
+ * to sleep; the conversion keeps running, and re-entering the mode does not start
+ * another one. Sleeping with interrupts disabled would never wake, so a caller
+ * that has them disabled gets a busy-waiting conversion instead.
+ *
+ * @return The result on the 10-bit scale.
+ */
+static uint16 ADC_convertQuiet(void) {
+	uint8 l_sreg = SREG;
+
+	if (!(l_sreg & (1 << SREG_I)))
+		return ADC_convert();
+	g_adcQuietDone = FALSE;
+	ADCSRA_REG.bits.adif = LOGIC_HIGH;
+	ADCSRA_REG.bits.adie = LOGIC_HIGH;
+	for (;;) {
+		cli();
+		if (g_adcQuietDone)
+			break;
+		Power_sleep(POWER_SLEEP_ADC_NOISE_REDUCTION);
+	}
+	ADCSRA_REG.bits.adie = LOGIC_LOW;
+	SREG = l_sreg;
+	return g_adcQuietResult;
 }
 
 /**
@@ -32,11 +232,231 @@ void ADC_init(void) {
  */
 uint16 ADC_readChannel(uint8 a_adcChannel) {
 
-	ADMUX_REG.byte = (ADMUX_REG.byte & 0xE0) | (a_adcChannel);
-	ADCSRA_REG.bits.adsc=LOGIC_HIGH;
+	if (g_adcQuietMode)
+		return ADC_readChannelQuiet(a_adcChannel);
+	/* The profile may change the ADC clock, which must not happen mid-conversion */
+	while (ADCSRA_REG.bits.adsc == LOGIC_HIGH)
+		;
+	if (ADC_selectChannel(a_adcChannel & 0x07))
+		(void) ADC_convert(); /* First result after the switch, thrown away */
+	return ADC_convert();
+}
 
-		while (ADCSRA_REG.bits.adif == LOGIC_LOW)
-			;
-		ADCSRA_REG.bits.adif = LOGIC_HIGH;
-		return ADC_REG.value;
+/**
+ * @brief Reads a channel with the CPU asleep in ADC Noise Reduction mode.
+ *
+ * @param a_adcChannel The ADC channel to read from (0-7).
+ * @return The 10-bit result, or 0 while a scan runs.
+ */
+uint16 ADC_readChannelQuiet(uint8 a_adcChannel) {
+	if (g_adcScanCount != 0)
+		return 0;
+
+	while (ADCSRA_REG.bits.adsc == LOGIC_HIGH)
+		;
+	if (ADC_selectChannel(a_adcChannel & 0x07))
+		(void) ADC_convertQuiet(); /* First result after the switch, thrown away */
+	return ADC_convertQuiet();
+}
+
+/**
+ * @brief Makes every blocking conversion a quiet one.
+ *
+ * @param a_quiet TRUE for quiet conversions, FALSE for busy-waiting ones.
+ */
+void ADC_setQuietMode(boolean a_quiet) {
+	g_adcQuietMode = a_quiet;
+}
+
+/**
+ * @brief Reads a channel with oversampling and decimation.
+ *
+ * @param a_adcChannel The ADC channel to read from (0-7).
+ * @param a_extraBits Bits to add, 0 to ADC_OVERSAMPLING_MAX_BITS.
+ * @return The (10 + a_extraBits)-bit result.
+ */
+uint16 ADC_readChannelOversampled(uint8 a_adcChannel, uint8 a_extraBits) {
+	uint16 l_sum = 0;
+	uint8 l_samples;
+
+	if (a_extraBits > ADC_OVERSAMPLING_MAX_BITS)
+		a_extraBits = ADC_OVERSAMPLING_MAX_BITS;
+	/* 4^n samples: each extra bit needs four times the conversions */
+	for (l_samples = 1 << (2 * a_extraBits); l_samples != 0; l_samples--) {
+		l_sum += ADC_readChannel(a_adcChannel);
+	}
+	/* Half an output step added first, so the shift rounds instead of truncating */
+	return (l_sum + ((1 << a_extraBits) >> 1)) >> a_extraBits;
+}
+
+/**
+ * @brief Sets how many bits the scan adds to a channel by oversampling.
+ *
+ * @param a_channel The ADC channel number (0-7).
+ * @param a_extraBits Bits to add, 0 to ADC_OVERSAMPLING_MAX_BITS.
+ */
+void ADC_setOversampling(uint8 a_channel, uint8 a_extraBits) {
+	if (a_extraBits > ADC_OVERSAMPLING_MAX_BITS)
+		a_extraBits = ADC_OVERSAMPLING_MAX_BITS;
+	g_adcChannelBits[a_channel & 0x07] = a_extraBits;
+}
+
+/**
+ * @brief Starts an interrupt driven scan over a list of channels.
+ *
+ * @param a_channels Array of ADC channel numbers (0-7).
+ * @param a_count Number of channels in the array.
+ */
+void ADC_startScan(const uint8 *a_channels, uint8 a_count) {
+	uint8 i;
+
+	ADC_stopScan();
+	if (a_count == 0 || a_count > ADC_SCAN_MAX_CHANNELS)
+		return;
+
+	for (i = 0; i < ADC_SCAN_MAX_CHANNELS; i++) {
+		g_adcChannelSlot[i] = ADC_SCAN_NO_SLOT;
+	}
+	for (i = 0; i < a_count; i++) {
+		uint8 l_channel = a_channels[i] & 0x07;
+		uint8 l_bits = g_adcChannelBits[l_channel];
+		uint16 l_value = ADC_readChannelOversampled(l_channel, l_bits);
+		g_adcScanChannels[i] = l_channel;
+		g_adcChannelSlot[l_channel] = i;
+		g_adcSlotBits[i] = l_bits;
+		g_adcScanBuffer[0][i] = l_value;
+		g_adcScanBuffer[1][i] = l_value;
+	}
+	g_adcScanCount = a_count;
+	g_adcScanIndex = 0;
+	g_adcAccumulator = 0;
+	g_adcSamplesLeft = 1 << (2 * g_adcSlotBits[0]);
+
+	/* Start the first conversion of the round, the ISR chains the rest */
+	g_adcScanDiscard = ADC_selectChannel(g_adcScanChannels[0]);
+	ADCSRA_REG.bits.adie = LOGIC_HIGH;
+	ADC_startConversion();
+}
+
+/**
+ * @brief Stops the scan after the conversion in progress.
+ */
+void ADC_stopScan(void) {
+	ADCSRA_REG.bits.adie = LOGIC_LOW;
+	while (ADCSRA_REG.bits.adsc == LOGIC_HIGH)
+		;
+	ADCSRA_REG.bits.adif = LOGIC_HIGH;
+	g_adcScanCount = 0;
+}
+
+/**
+ * @brief Returns the latest sample of a channel without blocking.
+ *
+ * @param a_channel The ADC channel number (0-7).
+ * @return The 10-bit result.
+ */
+uint16 ADC_getLatestSample(uint8 a_channel) {
+	uint16 l_value;
+	uint8 l_slot = g_adcChannelSlot[a_channel & 0x07];
+	uint8 l_sreg;
+
+	if (g_adcScanCount == 0)
+		return ADC_readChannel(a_channel);
+	if (l_slot == ADC_SCAN_NO_SLOT)
+		return 0;
+
+	/* The ISR may publish a new round between the two byte reads */
+	l_sreg = SREG;
+	cli();
+	l_value = g_adcScanBuffer[g_adcPublishedBuffer][l_slot];
+	SREG = l_sreg;
+	return l_value >> g_adcSlotBits[l_slot];
+}
+
+/**
+ * @brief Returns the latest sample of a channel at a chosen resolution.
+ *
+ * @param a_channel The ADC channel number (0-7).
+ * @param a_extraBits Bits above 10, 0 to ADC_OVERSAMPLING_MAX_BITS.
+ * @return The (10 + a_extraBits)-bit result.
+ */
+uint16 ADC_getLatestSampleHighRes(uint8 a_channel, uint8 a_extraBits) {
+	uint16 l_value;
+	uint8 l_slot = g_adcChannelSlot[a_channel & 0x07];
+	uint8 l_bits;
+	uint8 l_sreg;
+
+	if (g_adcScanCount == 0)
+		return ADC_readChannelOversampled(a_channel, a_extraBits);
+	if (l_slot == ADC_SCAN_NO_SLOT)
+		return 0;
+
+	l_sreg = SREG;
+	cli();
+	l_value = g_adcScanBuffer[g_adcPublishedBuffer][l_slot];
+	SREG = l_sreg;
+
+	l_bits = g_adcSlotBits[l_slot];
+	if (l_bits > a_extraBits)
+		return l_value >> (l_bits - a_extraBits);
+	return l_value << (a_extraBits - l_bits);
+}
+
+/**
+ * @brief Returns the number of scan rounds published so far (wraps at 256).
+ *
+ * With no scan running every finished blocking conversion counts as a round.
+ */
+uint8 ADC_getRoundCount(void) {
+	return g_adcRoundCount;
+}
+
+/**
+ * @brief ISR for the ADC conversion complete interrupt (ADC_vect).
+ *
+ * Drops the first result after a channel switch when the channel profile asks
+ * for it. Adds the result to the sum of the current slot and converts the same channel again
+ * until it has its 4^n samples. Then stores the decimated sum in the buffer being
+ * filled, publishes that buffer at the end of a round and starts the conversion of
+ * the next channel in the list (or, with auto-triggering, re-arms the trigger so
+ * the next event starts it). With no scan running the result belongs to
+ * ADC_readChannelQuiet().
+ */
+ISR(ADC_vect) {
+	uint8 l_fill;
+	uint8 l_bits;
+
+	if (g_adcScanCount == 0) {
+		g_adcQuietResult = ADC_readResult();
+		g_adcQuietDone = TRUE;
+		g_adcRoundCount++;
+		return;
+	}
+	if (g_adcScanDiscard) {
+		/* First conversion after switching to this channel: convert it again */
+		g_adcScanDiscard = FALSE;
+		ADC_startConversion();
+		return;
+	}
+	g_adcAccumulator += ADC_readResult();
+	if (--g_adcSamplesLeft != 0) {
+		/* Multiplexer still on this channel, no settling needed */
+		ADC_startConversion();
+		return;
+	}
+
+	l_fill = g_adcPublishedBuffer ^ 1;
+	l_bits = g_adcSlotBits[g_adcScanIndex];
+	g_adcScanBuffer[l_fill][g_adcScanIndex] =
+			(g_adcAccumulator + ((1 << l_bits) >> 1)) >> l_bits;
+	g_adcAccumulator = 0;
+	g_adcScanIndex++;
+	if (g_adcScanIndex >= g_adcScanCount) {
+		g_adcScanIndex = 0;
+		g_adcPublishedBuffer = l_fill;
+		g_adcRoundCount++;
+	}
+	g_adcSamplesLeft = 1 << (2 * g_adcSlotBits[g_adcScanIndex]);
+	g_adcScanDiscard = ADC_selectChannel(g_adcScanChannels[g_adcScanIndex]);
+	ADC_startConversion();
 }
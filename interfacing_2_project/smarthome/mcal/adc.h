@@ -5,6 +5,12 @@
  * This driver is responsible for initializing the ADC and reading analog values
  * from sensors such as the LM35 and LDR.
  *
+ * When Timer0_init() has set up a Timer 0 event as auto-trigger source (the
+ * `adcTrigger` field of Timer0_Config), blocking reads and the scan no longer start
+ * conversions themselves: each conversion waits for the next event, so samples are
+ * taken at a fixed phase of the PWM period. A conversion then takes one trigger
+ * period, which must be longer than the conversion time (13 ADC clocks).
+ *
  * @date 10 Oct 2024
  */
 
@@ -14,24 +20,215 @@
 #include "../common/std_types.h"
 #define ADC_MAXIMUM_VALUE    1023
 #define ADC_REF_VOLT_VALUE   2.56
+#define ADC_REF_VOLT_MV      2560   /* ADC_REF_VOLT_VALUE in millivolts, for integer scaling */
+/**
+ * @brief Conversion settings of one channel, applied whenever the multiplexer
+ * switches to it.
+ *
+ * Precision channels keep the slow clock and 10 bits; a channel that needs less
+ * can run at a faster ADC clock (above 200 kHz the ADC is only good for about
+ * 8 bits) and read one result byte.
+ */
+typedef struct {
+
+    /**
+     * @brief Voltage reference (REFS1:0 in ADMUX).
+     *
+     * Switching reference takes time to settle on the AREF capacitor; use
+     * discardFirst on channels with a reference of their own.
+     */
+    enum {
+        ADC_REFERENCE_AREF,        /**< External voltage on AREF */
+        ADC_REFERENCE_AVCC,        /**< AVCC, with a capacitor on AREF */
+        ADC_REFERENCE_INTERNAL = 3 /**< Internal 2.56 V, with a capacitor on AREF */
+    } reference;
+
+    /**
+     * @brief ADC clock prescaler (ADPS2:0 in ADCSRA); a conversion takes 13 ADC clocks.
+     */
+    enum {
+        ADC_PRESCALER_2 = 1, /**< 8 MHz at 16 MHz */
+        ADC_PRESCALER_4,     /**< 4 MHz */
+        ADC_PRESCALER_8,     /**< 2 MHz */
+        ADC_PRESCALER_16,    /**< 1 MHz */
+        ADC_PRESCALER_32,    /**< 500 kHz */
+        ADC_PRESCALER_64,    /**< 250 kHz */
+        ADC_PRESCALER_128    /**< 125 kHz, full 10-bit accuracy */
+    } prescaler;
+
+    /**
+     * @brief Left-adjusted result (ADLAR) of which only ADCH is read.
+     *
+     * The 8-bit result is still returned on the 10-bit scale, in the middle of its
+     * four-code step, so callers and tables do not change.
+     */
+    boolean eightBit;
+
+    /**
+     * @brief Throws away the first conversion after the multiplexer switches to
+     * this channel (or its reference changes), while the sample capacitor and
+     * the reference settle. Not needed with auto-triggering, where the input
+     * settles until the next trigger event.
+     */
+    boolean discardFirst;
+
+} ADC_ChannelProfile;
+
 /**
  * @brief Initializes the ADC with the following configurations:
  *        - Reference Voltage: Internal 2.56V.
  *        - Prescaler: F_CPU/128.
  *
+ * Every channel gets this profile (10 bits, nothing discarded) until
+ * ADC_setChannelProfile() changes it.
+ *
  * This function must be called once at the beginning to set up the ADC before reading any channels.
  */
 void ADC_init(void);
 
+/**
+ * @brief Sets the profile of a channel.
+ *
+ * Takes effect the next time the multiplexer switches to the channel; call it
+ * before ADC_startScan() for scanned channels.
+ *
+ * @param a_channel The ADC channel number (0-7).
+ * @param a_profile The settings, copied.
+ */
+void ADC_setChannelProfile(uint8 a_channel, const ADC_ChannelProfile *a_profile);
+
 /**
  * @brief Reads the analog value from the specified ADC channel.
  *
  * This function performs an analog-to-digital conversion for the given channel
- * and returns a 10-bit digital result.
+ * and returns a 10-bit digital result. The channel profile is applied first, and
+ * with discardFirst a channel switch costs a second conversion.
  *
  * @param channel_num The ADC channel number (0-7) to read from.
  * @return The 10-bit digital result of the ADC conversion.
  */
 uint16 ADC_readChannel(uint8 channel_num);
 
+/**
+ * @brief Reads a channel with the CPU asleep in ADC Noise Reduction mode.
+ *
+ * Entering the sleep mode starts the conversion, and the ADC interrupt wakes the
+ * CPU when the result is ready, so no CPU or I/O activity couples into the
+ * sample. The I/O clock stops for the conversion (about 104 us at /128): Timer 0
+ * and Timer 1 halt, the OC0 PWM output holds its level, and INT0 only sees a low
+ * level. The wake-up needs global interrupts: called with them disabled it runs a
+ * busy-waiting conversion instead, and the I flag is left as it was either way.
+ * Not available while a scan runs; returns 0 then.
+ *
+ * @param a_adcChannel The ADC channel number (0-7).
+ * @return The 10-bit result.
+ */
+uint16 ADC_readChannelQuiet(uint8 a_adcChannel);
+
+/**
+ * @brief Makes every blocking conversion a quiet one (see ADC_readChannelQuiet()).
+ *
+ * Applies to ADC_readChannel() and so to the oversampled reads and to
+ * ADC_getLatestSample()/ADC_getLatestSampleHighRes() while no scan runs.
+ *
+ * @param a_quiet TRUE for quiet conversions, FALSE for busy-waiting ones.
+ */
+void ADC_setQuietMode(boolean a_quiet);
+
+/**
+ * @brief Largest number of bits oversampling can add (4^3 = 64 samples, whose sum
+ * still fits in 16 bits).
+ */
+#define ADC_OVERSAMPLING_MAX_BITS 3
+
+/**
+ * @brief Reads a channel with oversampling and decimation.
+ *
+ * Sums 4^a_extraBits blocking conversions and divides the sum by 2^a_extraBits, rounded,
+ * giving a (10 + a_extraBits)-bit result. The extra bits are only real when the
+ * input carries about one LSB of noise or more; a perfectly quiet input just gives
+ * the 10-bit code shifted left.
+ *
+ * @param a_adcChannel The ADC channel number (0-7).
+ * @param a_extraBits Bits to add, 0 to ADC_OVERSAMPLING_MAX_BITS.
+ * @return The (10 + a_extraBits)-bit result.
+ */
+uint16 ADC_readChannelOversampled(uint8 a_adcChannel, uint8 a_extraBits);
+
+/**
+ * @brief Sets how many bits the scan adds to a channel by oversampling.
+ *
+ * The scan converts that channel 4^a_extraBits times in a row and publishes the
+ * decimated sum, so it costs 4^a_extraBits conversion times per round. Takes
+ * effect at the next ADC_startScan(). Every channel starts at 0 (plain 10-bit).
+ *
+ * @param a_channel The ADC channel number (0-7).
+ * @param a_extraBits Bits to add, 0 to ADC_OVERSAMPLING_MAX_BITS.
+ */
+void ADC_setOversampling(uint8 a_channel, uint8 a_extraBits);
+
+/**
+ * @brief Maximum number of channels in the scan list.
+ */
+#define ADC_SCAN_MAX_CHANNELS 8
+
+/**
+ * @brief Starts an interrupt driven scan over a list of channels.
+ *
+ * Each ADC conversion complete interrupt stores the result, switches the multiplexer
+ * to the next channel of the list and starts the next conversion, so the list is
+ * converted round after round with no CPU time spent waiting. Results of a finished
+ * round are published into one half of a double buffer while the next round fills
+ * the other half.
+ *
+ * One blocking conversion per channel is done before the interrupt is enabled so
+ * valid samples are available as soon as this function returns. The list is copied.
+ * Global interrupts must be enabled for the scan to run.
+ *
+ * @param a_channels Array of ADC channel numbers (0-7).
+ * @param a_count Number of channels in the array (1 to ADC_SCAN_MAX_CHANNELS).
+ */
+void ADC_startScan(const uint8 *a_channels, uint8 a_count);
+
+/**
+ * @brief Stops the scan after the conversion in progress.
+ */
+void ADC_stopScan(void);
+
+/**
+ * @brief Returns the latest sample of a channel without blocking.
+ *
+ * If the channel is part of the running scan the result of the last complete round
+ * is returned, decimated to 10 bits if the channel is oversampled. Otherwise, when no scan is running, a blocking conversion is done
+ * with ADC_readChannel(). A channel outside the list of a running scan reads 0.
+ *
+ * @param a_channel The ADC channel number (0-7).
+ * @return The 10-bit result.
+ */
+uint16 ADC_getLatestSample(uint8 a_channel);
+
+/**
+ * @brief Returns the latest sample of a channel at a chosen resolution.
+ *
+ * Same as ADC_getLatestSample() but scaled to 10 + a_extraBits bits: a channel
+ * oversampled to more bits is shifted down, one with fewer is shifted up. When no
+ * scan is running, ADC_readChannelOversampled() is used.
+ *
+ * @param a_channel The ADC channel number (0-7).
+ * @param a_extraBits Bits above 10, 0 to ADC_OVERSAMPLING_MAX_BITS.
+ * @return The (10 + a_extraBits)-bit result.
+ */
+uint16 ADC_getLatestSampleHighRes(uint8 a_channel, uint8 a_extraBits);
+
+/**
+ * @brief Returns the number of scan rounds published so far (wraps at 256).
+ *
+ * A driver that filters its channel compares it with the value it saw last, so each
+ * round enters the filter once however often the driver is called. While no scan
+ * is running every finished blocking conversion counts as a round, so the count
+ * has moved on by the next call after each read. Reading the count has no side
+ * effect.
+ */
+uint8 ADC_getRoundCount(void);
+
 #endif /* ADC_H_ */
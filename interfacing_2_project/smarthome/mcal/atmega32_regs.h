@@ -209,9 +209,9 @@ union TCCR1B_reg {
         uint8_t cs12 :1;
         uint8_t wgm12 :1;
         uint8_t wgm13 :1;
+        uint8_t :1;
         uint8_t ices1 :1;
         uint8_t icnc1 :1;
-        uint8_t :1;
     } bits;
 };
 
@@ -270,6 +270,17 @@ union OCR2_reg {
     uint8_t byte;
 };
 
+union ASSR_reg {
+    uint8_t byte;
+    struct {
+        uint8_t tcr2ub :1;
+        uint8_t ocr2ub :1;
+        uint8_t tcn2ub :1;
+        uint8_t as2 :1;
+        uint8_t :4;
+    } bits;
+};
+
 // Interrupt Registers
 union SREG_reg {
     uint8_t byte;
@@ -345,6 +356,10 @@ union ADCSRA_reg {
 union ADC_reg {
 
     uint16_t value;
+    struct {
+        uint8_t adcl;
+        uint8_t adch;
+    } bytes;
 };
 
 // EEPROM Registers
@@ -539,10 +554,10 @@ union SFIOR_reg {
         uint8_t psr2 :1;
         uint8_t pud :1;
         uint8_t acme :1;
+        uint8_t :1;
         uint8_t adts0 :1;
         uint8_t adts1 :1;
         uint8_t adts2 :1;
-        uint8_t :1;
     } bits;
 };
 
@@ -586,84 +601,126 @@ union SPMCR_reg {
     } bits;
 };
 
-// Memory-mapped register macros
-#define PORTA_REG   (*((volatile union PORTA_reg *)0x3B))
-#define DDRA_REG    (*((volatile union DDRA_reg *)0x3A))
-#define PINA_REG    (*((volatile union PINA_reg *)0x39))
-
-#define PORTB_REG   (*((volatile union PORTB_reg *)0x38))
-#define DDRB_REG    (*((volatile union DDRB_reg *)0x37))
-#define PINB_REG    (*((volatile union PINB_reg *)0x36))
+// External Interrupts
+union GICR_reg {
+    uint8_t byte;
+    struct {
+        uint8_t ivce :1;
+        uint8_t ivsel :1;
+        uint8_t :3;
+        uint8_t int2 :1;
+        uint8_t int0 :1;
+        uint8_t int1 :1;
+    } bits;
+};
 
-#define PORTC_REG   (*((volatile union PORTC_reg *)0x35))
-#define DDRC_REG    (*((volatile union DDRC_reg *)0x34))
-#define PINC_REG    (*((volatile union PINC_reg *)0x33))
+union GIFR_reg {
+    uint8_t byte;
+    struct {
+        uint8_t :5;
+        uint8_t intf2 :1;
+        uint8_t intf0 :1;
+        uint8_t intf1 :1;
+    } bits;
+};
 
-#define PORTD_REG   (*((volatile union PORTD_reg *)0x32))
-#define DDRD_REG    (*((volatile union DDRD_reg *)0x31))
-#define PIND_REG    (*((volatile union PIND_reg *)0x30))
+// Memory-mapped register macros
+#ifdef HOST_SIM
+// Host build: registers live in the simulator's register file, and every access
+// lets the simulated peripherals advance (see host/sim/sim.h)
+extern volatile uint8_t *SIM_accessRegister(uint8_t a_address);
+extern const volatile uint8_t *SIM_readFlags(uint8_t a_address);
+#define ATMEGA32_SFR(type, address) (*((volatile union type *)SIM_accessRegister(address)))
+// Read-only view of a flag register: reading it never clears a flag
+#define ATMEGA32_SFR_FLAGS(type, address) (*((const volatile union type *)SIM_readFlags(address)))
+#else
+#define ATMEGA32_SFR(type, address) (*((volatile union type *)(address)))
+#define ATMEGA32_SFR_FLAGS(type, address) (*((const volatile union type *)(address)))
+#endif
+
+#define PORTA_REG   ATMEGA32_SFR(PORTA_reg, 0x3B)
+#define DDRA_REG    ATMEGA32_SFR(DDRA_reg, 0x3A)
+#define PINA_REG    ATMEGA32_SFR(PINA_reg, 0x39)
+
+#define PORTB_REG   ATMEGA32_SFR(PORTB_reg, 0x38)
+#define DDRB_REG    ATMEGA32_SFR(DDRB_reg, 0x37)
+#define PINB_REG    ATMEGA32_SFR(PINB_reg, 0x36)
+
+#define PORTC_REG   ATMEGA32_SFR(PORTC_reg, 0x35)
+#define DDRC_REG    ATMEGA32_SFR(DDRC_reg, 0x34)
+#define PINC_REG    ATMEGA32_SFR(PINC_reg, 0x33)
+
+#define PORTD_REG   ATMEGA32_SFR(PORTD_reg, 0x32)
+#define DDRD_REG    ATMEGA32_SFR(DDRD_reg, 0x31)
+#define PIND_REG    ATMEGA32_SFR(PIND_reg, 0x30)
 
 // Timer/Counter 0
 
-#define TCCR0_REG   (*((volatile union TCCR0_reg *)0x53))
-#define TCNT0_REG   (*((volatile union TCNT0_reg *)0x52))
-#define OCR0_REG    (*((volatile union OCR0_reg *)0x5C))
+#define TCCR0_REG   ATMEGA32_SFR(TCCR0_reg, 0x53)
+#define TCNT0_REG   ATMEGA32_SFR(TCNT0_reg, 0x52)
+#define OCR0_REG    ATMEGA32_SFR(OCR0_reg, 0x5C)
 // Timer/Counter 1
-#define TCCR1A_REG  (*((volatile union TCCR1A_reg *)0x4F))
-#define TCCR1B_REG  (*((volatile union TCCR1B_reg *)0x4E))
-#define TCNT1_REG   (*((volatile union TCNT1_reg *)0x4C))
-#define OCR1A_REG   (*((volatile union OCR1A_reg *)0x4A))
-#define OCR1B_REG   (*((volatile union OCR1B_reg *)0x48))
-#define ICR1_REG    (*((volatile union ICR1_reg *)0x46))
+#define TCCR1A_REG  ATMEGA32_SFR(TCCR1A_reg, 0x4F)
+#define TCCR1B_REG  ATMEGA32_SFR(TCCR1B_reg, 0x4E)
+#define TCNT1_REG   ATMEGA32_SFR(TCNT1_reg, 0x4C)
+#define OCR1A_REG   ATMEGA32_SFR(OCR1A_reg, 0x4A)
+#define OCR1B_REG   ATMEGA32_SFR(OCR1B_reg, 0x48)
+#define ICR1_REG    ATMEGA32_SFR(ICR1_reg, 0x46)
 
 // Timer/Counter 2
-#define TCCR2_REG   (*((volatile union TCCR2_reg *)0x45))
-#define TCNT2_REG   (*((volatile union TCNT2_reg *)0x44))
-#define OCR2_REG    (*((volatile union OCR2_reg *)0x43))
+#define TCCR2_REG   ATMEGA32_SFR(TCCR2_reg, 0x45)
+#define TCNT2_REG   ATMEGA32_SFR(TCNT2_reg, 0x44)
+#define OCR2_REG    ATMEGA32_SFR(OCR2_reg, 0x43)
+#define ASSR_REG    ATMEGA32_SFR(ASSR_reg, 0x42)
 
 // Interrupt Registers
-#define SREG_REG    (*((volatile union SREG_reg *)0x5F))
-#define TIMSK_REG   (*((volatile union TIMSK_reg *)0x59))
-#define TIFR_REG    (*((volatile union TIFR_reg *)0x58))
+#define SREG_REG    ATMEGA32_SFR(SREG_reg, 0x5F)
+#define TIMSK_REG   ATMEGA32_SFR(TIMSK_reg, 0x59)
+#define TIFR_REG    ATMEGA32_SFR(TIFR_reg, 0x58)
+#define TIFR_FLAGS  ATMEGA32_SFR_FLAGS(TIFR_reg, 0x58) // for polling a flag without clearing the others
 
 // ADC Registers
-#define ADMUX_REG   (*((volatile union ADMUX_reg *)0x27))
-#define ADCSRA_REG  (*((volatile union ADCSRA_reg *)0x26))
-#define ADC_REG     (*((volatile union ADC_reg *)0x24))
+#define ADMUX_REG   ATMEGA32_SFR(ADMUX_reg, 0x27)
+#define ADCSRA_REG  ATMEGA32_SFR(ADCSRA_reg, 0x26)
+#define ADC_REG     ATMEGA32_SFR(ADC_reg, 0x24)
 
 // EEPROM Registers
-#define EEAR_REG    (*((volatile union EEAR_reg *)0x3E))
-#define EEDR_REG    (*((volatile union EEDR_reg *)0x3D))
-#define EECR_REG    (*((volatile union EECR_reg *)0x3C))
+#define EEAR_REG    ATMEGA32_SFR(EEAR_reg, 0x3E)
+#define EEDR_REG    ATMEGA32_SFR(EEDR_reg, 0x3D)
+#define EECR_REG    ATMEGA32_SFR(EECR_reg, 0x3C)
 
 // SPI Registers
-#define SPCR_REG    (*((volatile union SPCR_reg *)0x2D))
-#define SPSR_REG    (*((volatile union SPSR_reg *)0x2E))
-#define SPDR_REG    (*((volatile union SPDR_reg *)0x2F))
+#define SPCR_REG    ATMEGA32_SFR(SPCR_reg, 0x2D)
+#define SPSR_REG    ATMEGA32_SFR(SPSR_reg, 0x2E)
+#define SPDR_REG    ATMEGA32_SFR(SPDR_reg, 0x2F)
 
 // USART Registers
-#define UBRRH_REG   (*((volatile union UBRRH_reg *)0x40))
-#define UBRRL_REG   (*((volatile union UBRRL_reg *)0x29))
-#define UCSRA_REG   (*((volatile union UCSRA_reg *)0x2B))
-#define UCSRB_REG   (*((volatile union UCSRB_reg *)0x2A))
-#define UCSRC_REG   (*((volatile union UCSRC_reg *)0x40))
-#define UDR_REG     (*((volatile union UDR_reg *)0x2C))
+#define UBRRH_REG   ATMEGA32_SFR(UBRRH_reg, 0x40)
+#define UBRRL_REG   ATMEGA32_SFR(UBRRL_reg, 0x29)
+#define UCSRA_REG   ATMEGA32_SFR(UCSRA_reg, 0x2B)
+#define UCSRB_REG   ATMEGA32_SFR(UCSRB_reg, 0x2A)
+#define UCSRC_REG   ATMEGA32_SFR(UCSRC_reg, 0x40)
+#define UDR_REG     ATMEGA32_SFR(UDR_reg, 0x2C)
 
 // TWI Registers
-#define TWBR_REG    (*((volatile union TWBR_reg *)0x20))
-#define TWSR_REG    (*((volatile union TWSR_reg *)0x21))
-#define TWAR_REG    (*((volatile union TWAR_reg *)0x22))
-#define TWDR_REG    (*((volatile union TWDR_reg *)0x23))
-#define TWCR_REG    (*((volatile union TWCR_reg *)0x56))
+#define TWBR_REG    ATMEGA32_SFR(TWBR_reg, 0x20)
+#define TWSR_REG    ATMEGA32_SFR(TWSR_reg, 0x21)
+#define TWAR_REG    ATMEGA32_SFR(TWAR_reg, 0x22)
+#define TWDR_REG    ATMEGA32_SFR(TWDR_reg, 0x23)
+#define TWCR_REG    ATMEGA32_SFR(TWCR_reg, 0x56)
 
 // Watchdog Timer
-#define WDTCR_REG   (*((volatile union WDTCR_reg *)0x41))
+#define WDTCR_REG   ATMEGA32_SFR(WDTCR_reg, 0x41)
 
 // Oscillator and Power Management
-#define OSCCAL_REG  (*((volatile union OSCCAL_reg *)0x51))
-#define SFIOR_REG   (*((volatile union SFIOR_reg *)0x50))
-#define MCUCSR_REG  (*((volatile union MCUCSR_reg *)0x54))
-#define MCUCR_REG   (*((volatile union MCUCR_reg *)0x55))
-#define SPMCR_REG   (*((volatile union SPMCR_reg *)0x57))
+#define OSCCAL_REG  ATMEGA32_SFR(OSCCAL_reg, 0x51)
+#define SFIOR_REG   ATMEGA32_SFR(SFIOR_reg, 0x50)
+#define MCUCSR_REG  ATMEGA32_SFR(MCUCSR_reg, 0x54)
+#define MCUCR_REG   ATMEGA32_SFR(MCUCR_reg, 0x55)
+#define SPMCR_REG   ATMEGA32_SFR(SPMCR_reg, 0x57)
+
+// External Interrupts
+#define GICR_REG    ATMEGA32_SFR(GICR_reg, 0x5B)
+#define GIFR_REG    ATMEGA32_SFR(GIFR_reg, 0x5A)
 
 #endif // ATMEGA32_REGISTERS_H
@@ -0,0 +1,63 @@
+/**
+ * @file ext_int0.c
+ * @brief External Interrupt 0 (INT0) driver for ATmega32 microcontroller.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ *
+ * @see atmega32_regs.h
+ * @see ext_int0.h
+ */
+
+#include "../common/std_types.h"
+#include "atmega32_regs.h"
+#include "ext_int0.h"
+#include <avr/interrupt.h>
+
+/**
+ * @brief Bit position of the INT0 flag (INTF0) in GIFR.
+ */
+#define INT0_FLAG_BIT 6
+
+/**
+ * @brief Pointer to the callback function executed on INT0.
+ */
+static void (*volatile PTR2_INT0_CallBack)(void) = NULL_PTR;
+
+/**
+ * @brief Initializes INT0 with the given sense control and enables it.
+ *
+ * @param a_sense The sense control to use.
+ */
+void INT0_init(INT0_SenseControl a_sense) {
+    GICR_REG.bits.int0 = LOGIC_LOW; /* Changing ISC0x may raise a false interrupt */
+    MCUCR_REG.bits.isc00 = (a_sense & 0x01);
+    MCUCR_REG.bits.isc01 = (a_sense >> 1) & 0x01;
+    GIFR_REG.byte = (1 << INT0_FLAG_BIT); /* Flags clear by writing one; others untouched */
+    GICR_REG.bits.int0 = LOGIC_HIGH;
+}
+
+/**
+ * @brief Disables INT0.
+ */
+void INT0_deinit(void) {
+    GICR_REG.bits.int0 = LOGIC_LOW;
+}
+
+/**
+ * @brief Sets the callback function executed from the INT0 interrupt.
+ *
+ * @param a_ptr2func Pointer to the callback function.
+ */
+void INT0_setCallback(void (*a_ptr2func)(void)) {
+    PTR2_INT0_CallBack = a_ptr2func;
+}
+
+/**
+ * @brief ISR for External Interrupt 0 (INT0_vect).
+ */
+ISR(INT0_vect) {
+    if (PTR2_INT0_CallBack != NULL_PTR) {
+        PTR2_INT0_CallBack();
+    }
+}
@@ -0,0 +1,51 @@
+/**
+ * @file ext_int0.h
+ * @brief Header file for the External Interrupt 0 (INT0) driver for ATmega32.
+ *
+ * INT0 is shared with PD2. The driver selects the sense control (level or edge)
+ * in MCUCR, enables the interrupt in GICR and forwards the interrupt to a
+ * user callback.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef EXT_INT0_H_
+#define EXT_INT0_H_
+
+#include "../common/std_types.h"
+
+/**
+ * @brief Enumeration for the INT0 sense control (ISC01:ISC00 bits of MCUCR).
+ */
+typedef enum {
+    INT0_LOW_LEVEL,    /**< Interrupt while PD2 is low */
+    INT0_ANY_CHANGE,   /**< Interrupt on any logical change of PD2 */
+    INT0_FALLING_EDGE, /**< Interrupt on the falling edge of PD2 */
+    INT0_RISING_EDGE   /**< Interrupt on the rising edge of PD2 */
+} INT0_SenseControl;
+
+/**
+ * @brief Initializes INT0 with the given sense control and enables it.
+ *
+ * Any interrupt flag left over from before the call is cleared so only edges
+ * that happen after initialization are reported. Global interrupts must be
+ * enabled separately.
+ *
+ * @param a_sense The sense control to use.
+ */
+void INT0_init(INT0_SenseControl a_sense);
+
+/**
+ * @brief Disables INT0.
+ */
+void INT0_deinit(void);
+
+/**
+ * @brief Sets the callback function executed from the INT0 interrupt.
+ *
+ * @param a_ptr2func Pointer to the callback function.
+ */
+void INT0_setCallback(void (*a_ptr2func)(void));
+
+#endif /* EXT_INT0_H_ */
@@ -12,6 +12,7 @@
 #include "gpio.h"
 #include <avr/io.h>
 #include <avr/pgmspace.h>
+#include <avr/interrupt.h>
 #include "../common/common_macros.h"
 #include "../common/std_types.h"
 /**
@@ -24,8 +25,12 @@
  * @return Pointer to the corresponding location in RAM.
  */
 static uint8*
-PGM_readPtrToRam(const uint16_t a_addr16)
+PGM_readPtrToRam(const uintptr_t a_addr16)
     {
+#ifdef HOST_SIM
+    /* Host build: "flash" is ordinary memory and pointers are wider than 16 bits */
+    return *(uint8* const*) a_addr16;
+#else
     uint16_t ram_addr;
 
     /* Use inline assembly to read two bytes from program memory (flash)*/
@@ -38,6 +43,7 @@ PGM_readPtrToRam(const uint16_t a_addr16)
 
     /* Return the loaded 16-bit address as a pointer to RAM*/
     return (uint8*) ram_addr;
+#endif
     }
 
 /**
@@ -159,6 +165,33 @@ void GPIO_writePort(uint8 port_num, uint8 value)
 	    }
 	}
     }
+/**
+ * @brief Reads the pin levels of a whole GPIO PORT
+ *
+ * @param port_num Port_ID PORTA_ID, PORTB_IB ,...etc
+ * @return The 8-bit value of the PINx register, 0 for an invalid port.
+ */
+uint8 GPIO_readPort(uint8 port_num)
+    {
+    uint8 value = LOGIC_LOW;
+
+    switch (port_num)
+	{
+    case PORTA_ID:
+	value = PINA;
+	break;
+    case PORTB_ID:
+	value = PINB;
+	break;
+    case PORTC_ID:
+	value = PINC;
+	break;
+    case PORTD_ID:
+	value = PIND;
+	break;
+	}
+    return value;
+    }
 /**
  * @brief Sets the direction of a GPIO pin.
  *
@@ -364,7 +397,7 @@ void GPIO_ARR_setPinState(uint8 a_pin, uint8 a_value)
     if (a_pin > NUM_OF_PINS)
 	return;
     volatile uint8 *port = (volatile uint8*) PGM_readPtrToRam(
-	    (uint16) (&ioPins[a_pin].port_addr));
+	    (uintptr_t) (&ioPins[a_pin].port_addr));
     uint8 pin = pgm_read_byte(&(ioPins[a_pin].pin));
 
     if (a_value == HIGH)
@@ -391,9 +424,9 @@ void GPIO_ARR_setPinDirection(uint8 a_pin, uint8 a_state)
     if (a_pin > NUM_OF_PINS)
 	return;
     volatile uint8 *ddr = (volatile uint8*) PGM_readPtrToRam(
-	    (uint16) (&ioPins[a_pin].ddr_addr));
+	    (uintptr_t) (&ioPins[a_pin].ddr_addr));
     volatile uint8 *port = (volatile uint8*) PGM_readPtrToRam(
-	    (uint16) (&ioPins[a_pin].port_addr));
+	    (uintptr_t) (&ioPins[a_pin].port_addr));
     uint8 pin = pgm_read_byte(&(ioPins[a_pin].pin));
 
     if (a_state == PIN_INPUT)
@@ -424,7 +457,88 @@ uint8 GPIO_ARR_readPin(uint8 a_pin)
     if (a_pin > NUM_OF_PINS)
 	return 0;
     volatile uint8 *pin_addr = (volatile uint8*) PGM_readPtrToRam(
-	    (uint16) (&ioPins[a_pin].pin_addr));
+	    (uintptr_t) (&ioPins[a_pin].pin_addr));
     uint8 pin = pgm_read_byte(&(ioPins[a_pin].pin));
     return GET_BIT(*pin_addr, pin);
     }
+
+/**
+ * @brief Empties a batch of pin writes.
+ *
+ * @param a_batch Pointer to the batch to clear.
+ */
+void GPIO_BATCH_init(GPIO_Batch *a_batch)
+    {
+    uint8 port;
+    for (port = 0; port < NUM_OF_PORTS; port++)
+	{
+	a_batch->setMask[port] = 0;
+	a_batch->clearMask[port] = 0;
+	}
+    }
+
+/**
+ * @brief Adds a pin write to a batch.
+ *
+ * The port and bit are derived from the pin number itself, so no flash lookup is needed.
+ *
+ * @param a_batch Pointer to the batch being built.
+ * @param a_pin The pin, as a value of `GPIO_PINS_ARR`.
+ * @param a_value The desired state (HIGH or LOW).
+ */
+void GPIO_BATCH_setPinState(GPIO_Batch *a_batch, uint8 a_pin, uint8 a_value)
+    {
+    if (a_pin >= NUM_OF_PINS)
+	return;
+    uint8 port = a_pin / NUM_OF_PINS_PER_PORT;
+    uint8 pin = a_pin % NUM_OF_PINS_PER_PORT;
+
+    if (a_value == LOW)
+	{
+	SET_BIT(a_batch->clearMask[port], pin);
+	CLEAR_BIT(a_batch->setMask[port], pin);
+	}
+    else
+	{
+	SET_BIT(a_batch->setMask[port], pin);
+	CLEAR_BIT(a_batch->clearMask[port], pin);
+	}
+    }
+
+/**
+ * @brief Applies a batch of pin writes, one port write per touched port.
+ *
+ * @param a_batch Pointer to the batch to apply.
+ */
+void GPIO_BATCH_apply(const GPIO_Batch *a_batch)
+    {
+    uint8 port;
+    uint8 sreg = SREG;
+
+    cli();
+    for (port = 0; port < NUM_OF_PORTS; port++)
+	{
+	uint8 set = a_batch->setMask[port];
+	uint8 clear = a_batch->clearMask[port];
+
+	if ((set | clear) == 0)
+	    continue;
+
+	switch (port)
+	    {
+	case PORTA_ID:
+	    PORTA = (PORTA & ~clear) | set;
+	    break;
+	case PORTB_ID:
+	    PORTB = (PORTB & ~clear) | set;
+	    break;
+	case PORTC_ID:
+	    PORTC = (PORTC & ~clear) | set;
+	    break;
+	case PORTD_ID:
+	    PORTD = (PORTD & ~clear) | set;
+	    break;
+	    }
+	}
+    SREG = sreg;
+    }
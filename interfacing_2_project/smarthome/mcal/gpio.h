@@ -16,6 +16,8 @@
 
 
 #include "../common/std_types.h"
+#include "../common/common_macros.h"
+#include <avr/io.h>
 
 /*******************************************************************************
  *                                Definitions                                  *
@@ -108,6 +110,19 @@ typedef struct
 	volatile uint8 pin; /**< The pin number (0-7) on the port. */
     } gpioStruct;
 
+/**
+ * @brief Structure for collecting several pin writes and applying them together.
+ *
+ * Each port gets a set mask and a clear mask. Pins are added with `GPIO_BATCH_setPinState()`
+ * and `GPIO_BATCH_apply()` then updates every touched port with a single write, so
+ * related outputs (e.g. both H-bridge inputs) change at the same instant.
+ */
+typedef struct
+    {
+	uint8 setMask[NUM_OF_PORTS]; /**< Bits to drive HIGH on each port. */
+	uint8 clearMask[NUM_OF_PORTS]; /**< Bits to drive LOW on each port. */
+    } GPIO_Batch;
+
 /*******************************************************************************
  *                                Functions Prototypes                         *
  *******************************************************************************/
@@ -196,6 +211,14 @@ uint8 GPIO_ARR_readPin(uint8 a_pin);
  */
 
 void GPIO_writePort(uint8 port_num, uint8 value);
+
+/**
+ * @brief Reads the pin levels of a whole GPIO PORT
+ *
+ * @param port_num Port_ID PORTA_ID, PORTB_IB ,...etc
+ * @return The 8-bit value of the PINx register, 0 for an invalid port.
+ */
+uint8 GPIO_readPort(uint8 port_num);
 /**
  * @brief Sets the Direction of a GPIO PORT in the memory mapped registers
  *
@@ -203,6 +226,34 @@ void GPIO_writePort(uint8 port_num, uint8 value);
  * @param a_value The desired direction PORT_INPUT,PORT_OUTPUT or the desired value
  */
 void GPIO_setupPortDirection(uint8 port_num, uint8 direction);
+
+/**
+ * @brief Empties a batch of pin writes.
+ *
+ * @param a_batch Pointer to the batch to clear.
+ */
+void GPIO_BATCH_init(GPIO_Batch *a_batch);
+
+/**
+ * @brief Adds a pin write to a batch without touching the hardware.
+ *
+ * A later call for the same pin overrides the earlier one.
+ *
+ * @param a_batch Pointer to the batch being built.
+ * @param a_pin The pin, as a value of `GPIO_PINS_ARR` (GPIO_PA0 ... GPIO_PD7).
+ * @param a_value The desired state (HIGH or LOW).
+ */
+void GPIO_BATCH_setPinState(GPIO_Batch *a_batch, uint8 a_pin, uint8 a_value);
+
+/**
+ * @brief Applies all pin writes of a batch with one write per touched port.
+ *
+ * The read-modify-write of each port is done with interrupts disabled so it
+ * cannot undo a pin change made by an ISR on the same port.
+ *
+ * @param a_batch Pointer to the batch to apply.
+ */
+void GPIO_BATCH_apply(const GPIO_Batch *a_batch);
 /**
  * @enum GPIO_PortDirectionType
  * @brief Defines the possible directions for a GPIO port.
@@ -272,4 +323,153 @@ typedef enum
     GPIO_PD7 = 31 /**< Pin GPIO_PD7, corresponding to pin 7 in Port D */
     } GPIO_PINS_ARR;
 
+/*******************************************************************************
+ *                     Compile-Time Resolved Pin Access                        *
+ *******************************************************************************/
+
+/**
+ * @brief Port letter of every `GPIO_Pxn` pin.
+ *
+ * These macros let the preprocessor turn a `GPIO_Pxn` name (or any macro that
+ * expands to one, such as `LCD_RS`) into the PORTx, DDRx and PINx register names,
+ * so the `GPIO_STATIC_*` macros below need no lookup at run time.
+ */
+
+/**<Port A pins (GPIO_PA0 to GPIO_PA7)*/
+#define GPIO_PA0_PORT A
+#define GPIO_PA1_PORT A
+#define GPIO_PA2_PORT A
+#define GPIO_PA3_PORT A
+#define GPIO_PA4_PORT A
+#define GPIO_PA5_PORT A
+#define GPIO_PA6_PORT A
+#define GPIO_PA7_PORT A
+
+/**<Port B pins (GPIO_PB0 to GPIO_PB7)*/
+#define GPIO_PB0_PORT B
+#define GPIO_PB1_PORT B
+#define GPIO_PB2_PORT B
+#define GPIO_PB3_PORT B
+#define GPIO_PB4_PORT B
+#define GPIO_PB5_PORT B
+#define GPIO_PB6_PORT B
+#define GPIO_PB7_PORT B
+
+/**<Port C pins (GPIO_PC0 to GPIO_PC7)*/
+#define GPIO_PC0_PORT C
+#define GPIO_PC1_PORT C
+#define GPIO_PC2_PORT C
+#define GPIO_PC3_PORT C
+#define GPIO_PC4_PORT C
+#define GPIO_PC5_PORT C
+#define GPIO_PC6_PORT C
+#define GPIO_PC7_PORT C
+
+/**<Port D pins (GPIO_PD0 to GPIO_PD7)*/
+#define GPIO_PD0_PORT D
+#define GPIO_PD1_PORT D
+#define GPIO_PD2_PORT D
+#define GPIO_PD3_PORT D
+#define GPIO_PD4_PORT D
+#define GPIO_PD5_PORT D
+#define GPIO_PD6_PORT D
+#define GPIO_PD7_PORT D
+
+/**
+ * @brief Two-level token pasting helpers.
+ *
+ * The extra level makes sure macro arguments (e.g. `LCD_RS`) are expanded
+ * to their `GPIO_Pxn` name before being pasted.
+ */
+#define GPIO_CAT_(a, b) a##b
+#define GPIO_CAT(a, b)  GPIO_CAT_(a, b)
+
+/**
+ * @brief PORT, DDR and PIN registers of a `GPIO_Pxn` pin, resolved at compile time.
+ *
+ * @param pin A `GPIO_Pxn` enumerator name or a macro expanding to one.
+ */
+#define GPIO_STATIC_PORT_REG(pin) GPIO_CAT(PORT, GPIO_CAT(pin, _PORT))
+#define GPIO_STATIC_DDR_REG(pin)  GPIO_CAT(DDR, GPIO_CAT(pin, _PORT))
+#define GPIO_STATIC_PIN_REG(pin)  GPIO_CAT(PIN, GPIO_CAT(pin, _PORT))
+
+/**
+ * @brief Bit number (0-7) of a `GPIO_Pxn` pin inside its port.
+ */
+#define GPIO_STATIC_BIT(pin) ((pin) % NUM_OF_PINS_PER_PORT)
+
+/**
+ * @brief Sets the state of a GPIO pin known at compile time.
+ *
+ * Same behaviour as `GPIO_ARR_setPinState()` but the port and bit are resolved by the
+ * preprocessor, so a constant `a_value` compiles down to a single `sbi`/`cbi`
+ * instead of reading the `ioPins` table from flash.
+ *
+ * @param pin A `GPIO_Pxn` name or a macro expanding to one (e.g. `LCD_E`).
+ * @param a_value The desired state (HIGH or LOW).
+ */
+#define GPIO_STATIC_setPinState(pin, a_value)                          \
+    do {                                                               \
+        if ((a_value) == LOW) {                                        \
+            CLEAR_BIT(GPIO_STATIC_PORT_REG(pin), GPIO_STATIC_BIT(pin)); \
+        } else {                                                       \
+            SET_BIT(GPIO_STATIC_PORT_REG(pin), GPIO_STATIC_BIT(pin));   \
+        }                                                              \
+    } while (0)
+
+/**
+ * @brief Configures the direction of a GPIO pin known at compile time.
+ *
+ * Same behaviour as `GPIO_ARR_setPinDirection()` with the port and bit resolved
+ * by the preprocessor.
+ *
+ * @param pin A `GPIO_Pxn` name or a macro expanding to one.
+ * @param a_state The desired direction (PIN_INPUT, PIN_OUTPUT, or PIN_INPUT_PULLUP).
+ */
+#define GPIO_STATIC_setPinDirection(pin, a_state)                      \
+    do {                                                               \
+        if ((a_state) == PIN_OUTPUT) {                                 \
+            SET_BIT(GPIO_STATIC_DDR_REG(pin), GPIO_STATIC_BIT(pin));    \
+        } else {                                                       \
+            CLEAR_BIT(GPIO_STATIC_DDR_REG(pin), GPIO_STATIC_BIT(pin));  \
+            if ((a_state) == PIN_INPUT_PULLUP) {                       \
+                SET_BIT(GPIO_STATIC_PORT_REG(pin), GPIO_STATIC_BIT(pin)); \
+            }                                                          \
+        }                                                              \
+    } while (0)
+
+/**
+ * @brief Reads the state of a GPIO pin known at compile time.
+ *
+ * @param pin A `GPIO_Pxn` name or a macro expanding to one.
+ * @return The current state of the pin (1 for HIGH, 0 for LOW).
+ */
+#define GPIO_STATIC_readPin(pin) GET_BIT(GPIO_STATIC_PIN_REG(pin), GPIO_STATIC_BIT(pin))
+
+/**
+ * @brief Writes several bits of the port a `GPIO_Pxn` pin belongs to.
+ *
+ * A single read-modify-write of PORTx: the bits set in `a_mask` take their value
+ * from `a_value`, the other pins of the port keep their state. It is not atomic,
+ * so an ISR must not change other pins of the same port while it runs.
+ *
+ * @param pin Any `GPIO_Pxn` pin of the port, or a macro expanding to one.
+ * @param a_mask The bits to write.
+ * @param a_value The new value of those bits (bits outside `a_mask` are ignored).
+ */
+#define GPIO_STATIC_writePortMasked(pin, a_mask, a_value)              \
+    (GPIO_STATIC_PORT_REG(pin) = (uint8) ((GPIO_STATIC_PORT_REG(pin)   \
+            & ~(a_mask)) | ((a_value) & (a_mask))))
+
+/**
+ * @brief Sets the direction of several pins of the port a `GPIO_Pxn` pin belongs to.
+ *
+ * @param pin Any `GPIO_Pxn` pin of the port, or a macro expanding to one.
+ * @param a_mask The pins to configure.
+ * @param a_direction PORT_INPUT or PORT_OUTPUT.
+ */
+#define GPIO_STATIC_setPortDirectionMasked(pin, a_mask, a_direction)   \
+    (GPIO_STATIC_DDR_REG(pin) = (uint8) ((GPIO_STATIC_DDR_REG(pin)     \
+            & ~(a_mask)) | ((a_direction) & (a_mask))))
+
 #endif /* GPIO_H_ */
@@ -0,0 +1,32 @@
+/**
+ * @file power.c
+ * @brief Sleep mode driver for ATmega32 microcontroller.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ *
+ * @see atmega32_regs.h
+ * @see power.h
+ */
+
+#include "../common/std_types.h"
+#include "atmega32_regs.h"
+#include "power.h"
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+/**
+ * @brief Sleeps until an interrupt, then returns after its ISR has run.
+ *
+ * @param a_mode The sleep mode.
+ */
+void Power_sleep(Power_SleepMode a_mode) {
+    MCUCR_REG.bits.sm0 = (a_mode & 0x01);
+    MCUCR_REG.bits.sm1 = (a_mode >> 1) & 0x01;
+    MCUCR_REG.bits.sm2 = (a_mode >> 2) & 0x01;
+    MCUCR_REG.bits.se = LOGIC_HIGH;
+    /* SLEEP executes before any interrupt that is pending when SEI runs */
+    sei();
+    sleep_cpu();
+    MCUCR_REG.bits.se = LOGIC_LOW;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file power.h
+ * @brief Header file for the sleep mode driver for ATmega32.
+ *
+ * Stops the CPU until an interrupt wakes it. In Idle mode the timers, the ADC
+ * and every interrupt keep running. In ADC Noise Reduction mode the I/O clock
+ * stops as well, so the timers halt and only the ADC, a low level on INT0/INT1,
+ * INT2 and Timer 2 in asynchronous mode can wake the chip; entering it starts a
+ * conversion if the ADC is enabled.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#include "../common/std_types.h"
+
+/**
+ * @brief Sleep modes, as encoded in the SM2:SM0 bits of MCUCR.
+ */
+typedef enum {
+    POWER_SLEEP_IDLE = 0,               /**< CPU stopped, peripherals running */
+    POWER_SLEEP_ADC_NOISE_REDUCTION = 1 /**< CPU and I/O clock stopped, ADC running */
+} Power_SleepMode;
+
+/**
+ * @brief Sleeps until an interrupt, then returns after its ISR has run.
+ *
+ * Call it with global interrupts disabled, after checking that there is nothing
+ * to do: interrupts are enabled by the instruction just before SLEEP, so an
+ * interrupt that became pending after the check still wakes the CPU. Returns
+ * with global interrupts enabled.
+ *
+ * @param a_mode The sleep mode.
+ */
+void Power_sleep(Power_SleepMode a_mode);
+
+#endif /* POWER_H_ */
@@ -30,6 +30,23 @@
  */
 static volatile void (*PTR2_Timer0_CallBack)(void) = NULL_PTR;
 
+/**
+ * @brief Bit positions of the Timer 0 flags (TOV0, OCF0) in TIFR.
+ */
+#define TIMER0_TOV0_BIT 0
+#define TIMER0_OCF0_BIT 1
+
+/**
+ * @brief Sets the ADC auto-trigger source bits (ADTS2:0 in SFIOR).
+ *
+ * 3 selects the Timer 0 compare match, 4 the Timer 0 overflow.
+ */
+static void Timer0_setAdcTriggerSource(uint8 a_source) {
+    SFIOR_REG.bits.adts0 = GET_BIT(a_source, 0);
+    SFIOR_REG.bits.adts1 = GET_BIT(a_source, 1);
+    SFIOR_REG.bits.adts2 = GET_BIT(a_source, 2);
+}
+
 /**
  * @brief Initializes Timer 0 based on the provided configuration.
  *
@@ -107,6 +124,24 @@ void Timer0_init(Timer0_Config *a_timerConfig) {
             }
             break;
     }
+
+    /* Route the chosen event to the ADC; clearing its flag makes the next event an edge */
+    switch (a_timerConfig->adcTrigger) {
+        case TIMER0_ADC_TRIGGER_OVERFLOW:
+            Timer0_setAdcTriggerSource(4);
+            TIFR_REG.byte = (1 << TIMER0_TOV0_BIT);
+            ADCSRA_REG.bits.adate = LOGIC_HIGH;
+            break;
+
+        case TIMER0_ADC_TRIGGER_COMPARE:
+            Timer0_setAdcTriggerSource(3);
+            TIFR_REG.byte = (1 << TIMER0_OCF0_BIT);
+            ADCSRA_REG.bits.adate = LOGIC_HIGH;
+            break;
+
+        case TIMER0_ADC_TRIGGER_NONE:
+            break;
+    }
 }
 
 /**
@@ -134,6 +169,30 @@ void Timer0_setDutyCycle(uint8 a_duty) {
     OCR0_REG.byte = a_duty;
 }
 
+/**
+ * @brief Returns the current Timer 0 count.
+ *
+ * @return The current value of TCNT0.
+ */
+uint8 Timer0_getCount(void) {
+    return TCNT0_REG.byte;
+}
+
+/**
+ * @brief Returns the CPU cycles per Timer 0 count of the running clock source.
+ *
+ * Decoded from the CS02:0 bits in TCCR0, so it follows whatever prescaler the
+ * last Timer0_init() selected.
+ *
+ * @return 1, 8, 64, 256 or 1024; 0 if the timer is stopped or externally clocked.
+ */
+uint16 Timer0_getCyclesPerCount(void) {
+    static const uint16 l_cyclesPerCount[TIMER0_CS_BITMASK + 1] = {
+        0, 1, 8, 64, 256, 1024, 0, 0
+    };
+    return l_cyclesPerCount[TCCR0_REG.byte & TIMER0_CS_BITMASK];
+}
+
 
 /**
  * @brief ISR for Timer 0 Compare Match interrupt (TIMER0_COMP_vect).
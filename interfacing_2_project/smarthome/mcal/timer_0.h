@@ -134,6 +134,21 @@ typedef struct {
      */
     uint8 intialCount;
 
+    /**
+     * @brief ADC auto-trigger source taken from Timer 0.
+     *
+     * Anything but TIMER0_ADC_TRIGGER_NONE selects the event in the ADTS bits of
+     * SFIOR and sets ADATE in ADCSRA, so every ADC conversion starts on that event
+     * at a fixed phase of the PWM period instead of when the software asks for it.
+     * The event only triggers on its flag going high, so the flag must be cleared
+     * before each conversion; the ADC driver does that. NONE leaves the ADC alone.
+     */
+    enum {
+        TIMER0_ADC_TRIGGER_NONE,     /**< ADC triggering left as it is */
+        TIMER0_ADC_TRIGGER_OVERFLOW, /**< Convert on overflow (BOTTOM, where fast PWM sets OC0) */
+        TIMER0_ADC_TRIGGER_COMPARE   /**< Convert on compare match (where fast PWM clears OC0) */
+    } adcTrigger;
+
 } Timer0_Config;
 
 /**
@@ -142,7 +157,8 @@ typedef struct {
  * This function initializes Timer 0 using the settings provided in the
  * `Timer0_Config` structure. The user must set the timer mode, clock source,
  * compare output mode, interrupt enable/disable, compare match value (tick),
- * and the initial timer count before calling this function.
+ * and the initial timer count before calling this function. When an ADC trigger
+ * is chosen, the ADC auto-trigger is set up in the same call.
  *
  * @param a_timerConfig Pointer to `Timer0_Config` structure containing the desired settings.
  */
@@ -168,4 +184,21 @@ void Timer0_setCallback(volatile void (a_ptr2func)(void));
  */
 void Timer0_setDutyCycle(uint8 a_duty);
 
+/**
+ * @brief Returns the current Timer 0 count (TCNT0).
+ *
+ * Useful for short time-stamping: while Timer 0 runs the fan PWM (prescaler 8
+ * at 16 MHz) one count is 0.5 us and the counter wraps every 128 us.
+ *
+ * @return The current value of TCNT0.
+ */
+uint8 Timer0_getCount(void);
+
+/**
+ * @brief Returns the CPU cycles per Timer 0 count (the configured prescaler).
+ *
+ * @return 1, 8, 64, 256 or 1024; 0 if the timer is stopped or externally clocked.
+ */
+uint16 Timer0_getCyclesPerCount(void);
+
 #endif /* TIMER_0_H_ */
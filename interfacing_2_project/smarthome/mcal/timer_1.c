@@ -0,0 +1,244 @@
+/**
+ * @file timer_1.c
+ * @brief Timer 1 driver for ATmega32 microcontroller.
+ *
+ * Timer 1 is a free-running timebase or a PWM with ICR1 as TOP. Each interrupt
+ * source forwards to its own callback.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ *
+ * @see atmega32_regs.h
+ * @see timer_1.h
+ */
+
+#include "../common/common_macros.h"
+#include "../common/std_types.h"
+#include "atmega32_regs.h"
+#include "timer_1.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/**
+ * @brief Bit positions of the Timer 1 flags (ICF1, TOV1) in TIFR.
+ */
+#define TIMER1_ICF1_BIT  5
+#define TIMER1_TOV1_BIT  2
+
+/**
+ * @brief Waveform generation bits of the PWM modes with ICR1 as TOP: WGM11 in
+ * TCCR1A, WGM13:12 in TCCR1B.
+ */
+#define TIMER1_TCCR1A_WGM_ICR1_TOP       0x02
+#define TIMER1_TCCR1B_FAST_PWM_ICR1_TOP  0x18
+#define TIMER1_TCCR1B_PHASE_CORRECT_ICR1 0x10
+
+/**
+ * @brief Callback functions, one per Timer 1 event.
+ */
+static void (*volatile PTR2_Timer1_CallBack[TIMER1_EVENTS])(void) = {
+    NULL_PTR, NULL_PTR };
+
+/**
+ * @brief Initializes Timer 1 based on the provided configuration.
+ *
+ * @param a_timerConfig Pointer to `Timer1_Config` structure with the desired settings.
+ */
+void Timer1_init(const Timer1_Config *a_timerConfig) {
+
+    /* Leave a running timebase alone, other drivers count on it */
+    if (a_timerConfig->mode == TIMER1_MODE_NORMAL
+            && (TCCR1B_REG.byte & TIMER1_CS_BITMASK) == a_timerConfig->clockSource
+            && TCCR1A_REG.byte == 0) {
+        return;
+    }
+
+    switch (a_timerConfig->mode) {
+        case TIMER1_MODE_NORMAL:
+            /* WGM13:0 = 0, output compare pins disconnected */
+            TCCR1A_REG.byte = 0;
+            TCCR1B_REG.byte = 0;
+            break;
+
+        case TIMER1_MODE_FAST_PWM:
+            /* WGM13:0 = 14, outputs connected by Timer1_setDutyCycle() */
+            TCCR1B_REG.byte = 0;
+            TCCR1A_REG.byte = TIMER1_TCCR1A_WGM_ICR1_TOP;
+            TCCR1B_REG.byte = TIMER1_TCCR1B_FAST_PWM_ICR1_TOP;
+            break;
+
+        case TIMER1_MODE_PHASE_CORRECT_PWM:
+            /* WGM13:0 = 10 */
+            TCCR1B_REG.byte = 0;
+            TCCR1A_REG.byte = TIMER1_TCCR1A_WGM_ICR1_TOP;
+            TCCR1B_REG.byte = TIMER1_TCCR1B_PHASE_CORRECT_ICR1;
+            break;
+    }
+    if (a_timerConfig->mode != TIMER1_MODE_NORMAL) {
+        ICR1_REG.word = a_timerConfig->top;
+        OCR1A_REG.word = 0;
+        OCR1B_REG.word = 0;
+    }
+
+    /* Disable every Timer 1 interrupt until a user asks for it */
+    TIMSK_REG.bits.ticie1 = LOGIC_LOW;
+    TIMSK_REG.bits.ocie1a = LOGIC_LOW;
+    TIMSK_REG.bits.ocie1b = LOGIC_LOW;
+    TIMSK_REG.bits.toie1 = LOGIC_LOW;
+
+    TCNT1_REG.word = 0;
+    TCCR1B_REG.byte |= (a_timerConfig->clockSource & TIMER1_CS_BITMASK);
+}
+
+/**
+ * @brief Sets the callback function executed for one Timer 1 event.
+ *
+ * @param a_event The event.
+ * @param a_ptr2func Pointer to the callback function, or NULL_PTR to remove it.
+ */
+void Timer1_setCallback(Timer1_Event a_event, void (*a_ptr2func)(void)) {
+    if (a_event < TIMER1_EVENTS) {
+        PTR2_Timer1_CallBack[a_event] = a_ptr2func;
+    }
+}
+
+/**
+ * @brief Enables or disables the interrupt of the overflow or capture event.
+ *
+ * A flag left from before the interrupt is enabled is dropped, so the first
+ * interrupt reports a fresh event.
+ *
+ * @param a_event TIMER1_EVENT_OVERFLOW or TIMER1_EVENT_CAPTURE.
+ * @param a_enable TRUE to enable the interrupt, FALSE to disable it.
+ */
+void Timer1_setEventInterrupt(Timer1_Event a_event, boolean a_enable) {
+    uint8 l_sreg = SREG;
+    uint8 l_bit = a_enable ? LOGIC_HIGH : LOGIC_LOW;
+
+    cli();
+    if (a_event == TIMER1_EVENT_OVERFLOW) {
+        if (a_enable && !TIMSK_REG.bits.toie1) {
+            TIFR_REG.byte = (1 << TIMER1_TOV1_BIT);
+        }
+        TIMSK_REG.bits.toie1 = l_bit;
+    } else if (a_event == TIMER1_EVENT_CAPTURE) {
+        if (a_enable && !TIMSK_REG.bits.ticie1) {
+            TIFR_REG.byte = (1 << TIMER1_ICF1_BIT);
+        }
+        TIMSK_REG.bits.ticie1 = l_bit;
+    }
+    SREG = l_sreg;
+}
+
+/**
+ * @brief Selects the edge that captures TCNT1 into ICR1 on ICP1 (PD6).
+ *
+ * @param a_edge The capturing edge.
+ * @param a_noiseCanceler TRUE to filter the input.
+ */
+void Timer1_setCaptureEdge(Timer1_CaptureEdge a_edge, boolean a_noiseCanceler) {
+    uint8 l_sreg = SREG;
+
+    cli();
+    TCCR1B_REG.bits.ices1 = (a_edge == TIMER1_CAPTURE_RISING) ? LOGIC_HIGH : LOGIC_LOW;
+    TCCR1B_REG.bits.icnc1 = a_noiseCanceler ? LOGIC_HIGH : LOGIC_LOW;
+    /* Changing ICES1 may raise the flag by itself */
+    TIFR_REG.byte = (1 << TIMER1_ICF1_BIT);
+    SREG = l_sreg;
+}
+
+/**
+ * @brief Returns the count captured by the last ICP1 edge.
+ *
+ * ICR1 is read through the shared TEMP register, so interrupts are held off for
+ * the two byte reads.
+ */
+uint16 Timer1_getCapture(void) {
+    uint8 l_sreg = SREG;
+    uint16 l_capture;
+
+    cli();
+    l_capture = ICR1_REG.word;
+    SREG = l_sreg;
+    return l_capture;
+}
+
+/**
+ * @brief Returns the current Timer 1 count.
+ *
+ * TCNT1 is read through the shared TEMP register, so interrupts are held off
+ * for the two byte reads.
+ *
+ * @return The current value of TCNT1.
+ */
+uint16 Timer1_getCount(void) {
+    uint8 l_sreg = SREG;
+    uint16 l_count;
+
+    cli();
+    l_count = TCNT1_REG.word;
+    SREG = l_sreg;
+    return l_count;
+}
+
+/**
+ * @brief Tells whether a wrap of TCNT1 is still waiting for its overflow interrupt.
+ *
+ * @return TRUE if TOV1 is set.
+ */
+boolean Timer1_isOverflowPending(void) {
+    return TIFR_FLAGS.bits.tov1;
+}
+
+/**
+ * @brief Clears a pending overflow (TOV1), so its interrupt does not run for it.
+ */
+void Timer1_clearOverflow(void) {
+    TIFR_REG.byte = (1 << TIMER1_TOV1_BIT);
+}
+
+/**
+ * @brief Sets the duty of a PWM output and connects it (non-inverting).
+ *
+ * @param a_channel The output: OC1A or OC1B.
+ * @param a_duty 0 (off) to TOP (always high).
+ */
+void Timer1_setDutyCycle(Timer1_Channel a_channel, uint16 a_duty) {
+    uint8 l_sreg = SREG;
+    uint8 l_connect = (a_duty != 0) ? LOGIC_HIGH : LOGIC_LOW;
+    uint16 l_top;
+
+    /* 16-bit accesses go through the shared TEMP register */
+    cli();
+    l_top = ICR1_REG.word;
+    if (a_duty > l_top) {
+        a_duty = l_top;
+    }
+    /* OCR1x is double buffered in the PWM modes; COM1x1 = 1, COM1x0 = 0 is non-inverting */
+    if (a_channel == TIMER1_CHANNEL_A) {
+        OCR1A_REG.word = a_duty;
+        TCCR1A_REG.bits.com1a1 = l_connect;
+    } else {
+        OCR1B_REG.word = a_duty;
+        TCCR1A_REG.bits.com1b1 = l_connect;
+    }
+    SREG = l_sreg;
+}
+
+/**
+ * @brief ISR for Timer 1 Overflow (TIMER1_OVF_vect).
+ */
+ISR(TIMER1_OVF_vect) {
+    if (PTR2_Timer1_CallBack[TIMER1_EVENT_OVERFLOW] != NULL_PTR) {
+        PTR2_Timer1_CallBack[TIMER1_EVENT_OVERFLOW]();
+    }
+}
+
+/**
+ * @brief ISR for Timer 1 Input Capture (TIMER1_CAPT_vect).
+ */
+ISR(TIMER1_CAPT_vect) {
+    if (PTR2_Timer1_CallBack[TIMER1_EVENT_CAPTURE] != NULL_PTR) {
+        PTR2_Timer1_CallBack[TIMER1_EVENT_CAPTURE]();
+    }
+}
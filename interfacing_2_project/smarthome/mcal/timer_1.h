@@ -0,0 +1,199 @@
+/**
+ * @file timer_1.h
+ * @brief Header file for the Timer 1 driver for ATmega32.
+ *
+ * Timer 1 runs as a free-running 16-bit timebase shared by several drivers.
+ * Each event (overflow, input capture) has its own callback, so one timer
+ * serves several independent users.
+ *
+ * It can instead run as a 16-bit PWM with ICR1 as TOP, which sets the PWM
+ * frequency independently of the prescaler, on OC1A (PD5) and OC1B (PD4). The
+ * counter then wraps at TOP and input capture is off, so the timebase is not
+ * available: one build uses Timer 1 for one or the other.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef TIMER_1_H_
+#define TIMER_1_H_
+
+#include "../common/std_types.h"
+
+/**
+ * @def TIMER1_CS_BITMASK
+ * @brief A bitmask for the clock source bits (CS12, CS11, CS10) in TCCR1B.
+ */
+#define TIMER1_CS_BITMASK 0x07
+
+/**
+ * @def TIMER1_TICKS_PER_US
+ * @brief Timer 1 counts per microsecond with the shared prescaler of 8.
+ *
+ * At 16 MHz one count is 0.5 us and the counter wraps every 32.768 ms.
+ */
+#define TIMER1_TICKS_PER_US (F_CPU / 8000000UL)
+
+/**
+ * @def TIMER1_FAST_PWM_TOP
+ * @brief ICR1 value giving a fast PWM frequency in Hz, for a prescaler of 1, 8, 64...
+ *
+ * The duty then has TOP + 1 steps: 25 kHz with no prescaler gives TOP = 639.
+ */
+#define TIMER1_FAST_PWM_TOP(hz, prescaler) \
+    ((uint16) (F_CPU / ((uint32) (prescaler) * (hz)) - 1))
+
+/**
+ * @def TIMER1_PHASE_CORRECT_PWM_TOP
+ * @brief ICR1 value giving a phase correct PWM frequency in Hz.
+ *
+ * The counter goes up and down, so TOP is half the fast PWM one for the same
+ * frequency: 25 kHz with no prescaler gives TOP = 320.
+ */
+#define TIMER1_PHASE_CORRECT_PWM_TOP(hz, prescaler) \
+    ((uint16) (F_CPU / (2UL * (prescaler) * (hz))))
+
+/**
+ * @brief Timer 1 configuration structure.
+ */
+typedef struct {
+
+    /**
+     * @brief Enumeration for Timer 1 modes.
+     */
+    enum {
+        TIMER1_MODE_NORMAL,           /**< Normal mode, free-running from 0x0000 to 0xFFFF */
+        TIMER1_MODE_FAST_PWM,         /**< Fast PWM from 0 to ICR1 (mode 14) */
+        TIMER1_MODE_PHASE_CORRECT_PWM /**< Phase correct PWM from 0 to ICR1 and back (mode 10) */
+    } mode;
+
+    /**
+     * @brief Enumeration for Timer 1 clock sources.
+     */
+    enum {
+        TIMER1_NO_CLOCK,               /**< No clock source (Timer is stopped) */
+        TIMER1_PRESCALER_1,            /**< No prescaler (system clock) */
+        TIMER1_PRESCALER_8,            /**< Prescaler of 8 */
+        TIMER1_PRESCALER_64,           /**< Prescaler of 64 */
+        TIMER1_PRESCALER_256,          /**< Prescaler of 256 */
+        TIMER1_PRESCALER_1024,         /**< Prescaler of 1024 */
+        TIMER1_EXTERNAL_CLOCK_FALLING, /**< External clock on falling edge of T1 */
+        TIMER1_EXTERNAL_CLOCK_RISING   /**< External clock on rising edge of T1 */
+    } clockSource;
+
+    /**
+     * @brief TOP (ICR1) in the PWM modes, see TIMER1_FAST_PWM_TOP(). Unused in
+     * normal mode.
+     */
+    uint16 top;
+
+} Timer1_Config;
+
+/**
+ * @brief Timer 1 events that can have a callback.
+ */
+typedef enum {
+    TIMER1_EVENT_OVERFLOW,  /**< TCNT1 wrapped (TIMER1_OVF_vect) */
+    TIMER1_EVENT_CAPTURE,   /**< Input capture on ICP1 (TIMER1_CAPT_vect) */
+    TIMER1_EVENTS
+} Timer1_Event;
+
+/**
+ * @brief Output compare units, used as the PWM outputs OC1A and OC1B.
+ */
+typedef enum {
+    TIMER1_CHANNEL_A, /**< OCR1A */
+    TIMER1_CHANNEL_B  /**< OCR1B */
+} Timer1_Channel;
+
+/**
+ * @brief Edges of ICP1 (PD6) that trigger an input capture.
+ */
+typedef enum {
+    TIMER1_CAPTURE_FALLING, /**< ICES1 = 0 */
+    TIMER1_CAPTURE_RISING   /**< ICES1 = 1 */
+} Timer1_CaptureEdge;
+
+/**
+ * @brief Initializes Timer 1 with the specified configuration.
+ *
+ * The counter keeps running if it was already started in normal mode with the
+ * same prescaler, so every user of the shared timebase may call this. A PWM mode
+ * always restarts the counter, with both outputs disconnected and both duties at
+ * 0 until Timer1_setDutyCycle(). All Timer 1 interrupts
+ * start disabled; they are enabled by the drivers that own the events.
+ *
+ * @param a_timerConfig Pointer to `Timer1_Config` structure containing the desired settings.
+ */
+void Timer1_init(const Timer1_Config *a_timerConfig);
+
+/**
+ * @brief Sets the callback function executed for one Timer 1 event.
+ *
+ * @param a_event The event.
+ * @param a_ptr2func Pointer to the callback function, or NULL_PTR to remove it.
+ */
+void Timer1_setCallback(Timer1_Event a_event, void (*a_ptr2func)(void));
+
+/**
+ * @brief Enables or disables the interrupt of the overflow or capture event.
+ *
+ * @param a_event TIMER1_EVENT_OVERFLOW or TIMER1_EVENT_CAPTURE.
+ * @param a_enable TRUE to enable the interrupt, FALSE to disable it.
+ */
+void Timer1_setEventInterrupt(Timer1_Event a_event, boolean a_enable);
+
+/**
+ * @brief Selects the edge that captures TCNT1 into ICR1 on ICP1 (PD6).
+ *
+ * With the noise canceler on, the input must hold its level for 4 CPU cycles, and
+ * the capture comes 4 cycles after the edge. A capture flag left from before is
+ * cleared. Input capture only works in normal mode: the PWM modes use ICR1 as TOP.
+ *
+ * @param a_edge The capturing edge.
+ * @param a_noiseCanceler TRUE to filter the input.
+ */
+void Timer1_setCaptureEdge(Timer1_CaptureEdge a_edge, boolean a_noiseCanceler);
+
+/**
+ * @brief Returns the count captured by the last ICP1 edge (ICR1).
+ */
+uint16 Timer1_getCapture(void);
+
+/**
+ * @brief Returns the current Timer 1 count (TCNT1).
+ *
+ * @return The current value of TCNT1.
+ */
+uint16 Timer1_getCount(void);
+
+/**
+ * @brief Tells whether a wrap of TCNT1 is still waiting for its overflow interrupt.
+ *
+ * Reads TOV1 without clearing it. A reader that runs with interrupts disabled, or
+ * in an interrupt of higher priority than TIMER1_OVF_vect, can see a wrap this way
+ * before the overflow interrupt does.
+ *
+ * @return TRUE if TOV1 is set.
+ */
+boolean Timer1_isOverflowPending(void);
+
+/**
+ * @brief Clears a pending overflow (TOV1), so its interrupt does not run for it.
+ */
+void Timer1_clearOverflow(void);
+
+/**
+ * @brief Sets the duty of a PWM output and connects it (non-inverting).
+ *
+ * The pin (PD5 for A, PD4 for B) must be an output and its PORT bit low. A duty
+ * of 0 disconnects the output, so the pin stays low instead of the one-count
+ * pulse fast PWM gives for OCR1x = 0. Other values take effect at the next TOP
+ * (OCR1x is double buffered), without glitches.
+ *
+ * @param a_channel The output: OC1A or OC1B.
+ * @param a_duty 0 (off) to TOP (always high); above TOP is taken as TOP.
+ */
+void Timer1_setDutyCycle(Timer1_Channel a_channel, uint16 a_duty);
+
+#endif /* TIMER_1_H_ */
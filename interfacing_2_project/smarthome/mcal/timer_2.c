@@ -0,0 +1,146 @@
+/**
+ * @file timer_2.c
+ * @brief Timer 2 driver for ATmega32 microcontroller.
+ *
+ * Timer 2 gives a periodic tick in CTC mode. Each interrupt source forwards to its
+ * own callback.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ *
+ * @see atmega32_regs.h
+ * @see timer_2.h
+ */
+
+#include "../common/common_macros.h"
+#include "../common/std_types.h"
+#include "atmega32_regs.h"
+#include "timer_2.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/**
+ * @brief Bit positions of the Timer 2 flags (TOV2, OCF2) in TIFR.
+ */
+#define TIMER2_TOV2_BIT 6
+#define TIMER2_OCF2_BIT 7
+
+/**
+ * @brief Callback functions, one per Timer 2 event.
+ */
+static void (*volatile PTR2_Timer2_CallBack[TIMER2_EVENTS])(void) = { NULL_PTR, NULL_PTR };
+
+/**
+ * @brief Initializes Timer 2 based on the provided configuration.
+ *
+ * @param a_timerConfig Pointer to `Timer2_Config` structure with the desired settings.
+ */
+void Timer2_init(const Timer2_Config *a_timerConfig) {
+    uint8 l_sreg = SREG;
+
+    cli();
+    TIMSK_REG.bits.ocie2 = LOGIC_LOW;
+    TIMSK_REG.bits.toie2 = LOGIC_LOW;
+    TCCR2_REG.byte = 0;
+    TCNT2_REG.byte = 0;
+    OCR2_REG.byte = a_timerConfig->compare;
+    /* Clocked from the I/O clock, not TOSC1 */
+    ASSR_REG.byte = 0;
+
+    /* WGM21 alone selects CTC; COM21:0 = 0 leaves OC2 (PD7) a plain pin */
+    TCCR2_REG.bits.wgm21 = (a_timerConfig->mode == TIMER2_MODE_CTC) ? LOGIC_HIGH : LOGIC_LOW;
+    /* Drop flags left from before, then start the clock */
+    TIFR_REG.byte = (1 << TIMER2_TOV2_BIT) | (1 << TIMER2_OCF2_BIT);
+    TCCR2_REG.byte |= a_timerConfig->clockSource;
+    SREG = l_sreg;
+}
+
+/**
+ * @brief Sets the callback of one Timer 2 event and enables its interrupt.
+ *
+ * @param a_event The event.
+ * @param a_ptr2func Pointer to the callback function, or NULL_PTR.
+ */
+void Timer2_setCallback(Timer2_Event a_event, void (*a_ptr2func)(void)) {
+    uint8 l_enable = (a_ptr2func != NULL_PTR) ? LOGIC_HIGH : LOGIC_LOW;
+    uint8 l_sreg = SREG;
+
+    cli();
+    PTR2_Timer2_CallBack[a_event] = a_ptr2func;
+    if (a_event == TIMER2_EVENT_COMPARE) {
+        TIMSK_REG.bits.ocie2 = l_enable;
+    } else {
+        TIMSK_REG.bits.toie2 = l_enable;
+    }
+    SREG = l_sreg;
+}
+
+/**
+ * @brief Returns the current Timer 2 count.
+ *
+ * @return The current value of TCNT2.
+ */
+uint8 Timer2_getCount(void) {
+    return TCNT2_REG.byte;
+}
+
+/**
+ * @brief Tells whether a compare match is still waiting for its interrupt.
+ *
+ * @return TRUE if OCF2 is set.
+ */
+boolean Timer2_isComparePending(void) {
+    return TIFR_FLAGS.bits.ocf2;
+}
+
+/**
+ * @brief Runs the compare callback if a match is pending, without the interrupt.
+ *
+ * @return TRUE if a match was pending and the callback was run, FALSE otherwise.
+ */
+boolean Timer2_pollCompare(void) {
+    uint8 l_sreg = SREG;
+
+    cli();
+    if (!TIFR_FLAGS.bits.ocf2) {
+        SREG = l_sreg;
+        return FALSE;
+    }
+    TIFR_REG.byte = (1 << TIMER2_OCF2_BIT);
+    if (PTR2_Timer2_CallBack[TIMER2_EVENT_COMPARE] != NULL_PTR) {
+        PTR2_Timer2_CallBack[TIMER2_EVENT_COMPARE]();
+    }
+    SREG = l_sreg;
+    return TRUE;
+}
+
+/**
+ * @brief Stops Timer 2 and disables its interrupts.
+ */
+void Timer2_deInit(void) {
+    uint8 l_sreg = SREG;
+
+    cli();
+    TIMSK_REG.bits.ocie2 = LOGIC_LOW;
+    TIMSK_REG.bits.toie2 = LOGIC_LOW;
+    TCCR2_REG.byte = 0;
+    SREG = l_sreg;
+}
+
+/**
+ * @brief ISR for Timer 2 Compare Match (TIMER2_COMP_vect).
+ */
+ISR(TIMER2_COMP_vect) {
+    if (PTR2_Timer2_CallBack[TIMER2_EVENT_COMPARE] != NULL_PTR) {
+        PTR2_Timer2_CallBack[TIMER2_EVENT_COMPARE]();
+    }
+}
+
+/**
+ * @brief ISR for Timer 2 Overflow (TIMER2_OVF_vect).
+ */
+ISR(TIMER2_OVF_vect) {
+    if (PTR2_Timer2_CallBack[TIMER2_EVENT_OVERFLOW] != NULL_PTR) {
+        PTR2_Timer2_CallBack[TIMER2_EVENT_OVERFLOW]();
+    }
+}
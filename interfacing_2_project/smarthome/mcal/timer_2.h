@@ -0,0 +1,120 @@
+/**
+ * @file timer_2.h
+ * @brief Header file for the Timer 2 driver for ATmega32.
+ *
+ * Timer 2 runs as a periodic tick: in CTC mode the counter restarts at OCR2, so
+ * the compare interrupt comes at a fixed rate without being re-armed. Each event
+ * (overflow, compare) has its own callback, and setting a callback enables the
+ * interrupt of its event.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef TIMER_2_H_
+#define TIMER_2_H_
+
+#include "../common/std_types.h"
+
+/**
+ * @def TIMER2_CTC_COMPARE
+ * @brief OCR2 value giving a CTC period in microseconds, for a prescaler of 1, 8, 32...
+ *
+ * The period is OCR2 + 1 counts, at most 256: 1000 us with a prescaler of 64
+ * gives OCR2 = 249.
+ */
+#define TIMER2_CTC_COMPARE(us, prescaler) \
+    ((uint8) ((F_CPU / 1000000UL) * (us) / (prescaler) - 1))
+
+/**
+ * @brief Timer 2 configuration structure.
+ */
+typedef struct {
+
+    /**
+     * @brief Enumeration for Timer 2 modes.
+     */
+    enum {
+        TIMER2_MODE_NORMAL, /**< Normal mode, free-running from 0x00 to 0xFF */
+        TIMER2_MODE_CTC     /**< Clear timer on compare match: 0 to OCR2 */
+    } mode;
+
+    /**
+     * @brief Enumeration for Timer 2 clock sources.
+     */
+    enum {
+        TIMER2_NO_CLOCK,       /**< No clock source (Timer is stopped) */
+        TIMER2_PRESCALER_1,    /**< No prescaler (system clock) */
+        TIMER2_PRESCALER_8,    /**< Prescaler of 8 */
+        TIMER2_PRESCALER_32,   /**< Prescaler of 32 */
+        TIMER2_PRESCALER_64,   /**< Prescaler of 64 */
+        TIMER2_PRESCALER_128,  /**< Prescaler of 128 */
+        TIMER2_PRESCALER_256,  /**< Prescaler of 256 */
+        TIMER2_PRESCALER_1024  /**< Prescaler of 1024 */
+    } clockSource;
+
+    /**
+     * @brief Compare value (OCR2), TOP in CTC mode; see TIMER2_CTC_COMPARE().
+     */
+    uint8 compare;
+
+} Timer2_Config;
+
+/**
+ * @brief Timer 2 events that can have a callback.
+ */
+typedef enum {
+    TIMER2_EVENT_OVERFLOW, /**< TCNT2 wrapped (TIMER2_OVF_vect) */
+    TIMER2_EVENT_COMPARE,  /**< Compare match on OCR2 (TIMER2_COMP_vect) */
+    TIMER2_EVENTS
+} Timer2_Event;
+
+/**
+ * @brief Initializes Timer 2 with the specified configuration.
+ *
+ * The counter restarts from 0, clocked from the system clock (not the
+ * asynchronous TOSC1 input), with OC2 disconnected. Both Timer 2 interrupts start
+ * disabled; Timer2_setCallback() enables them.
+ *
+ * @param a_timerConfig Pointer to `Timer2_Config` structure containing the desired settings.
+ */
+void Timer2_init(const Timer2_Config *a_timerConfig);
+
+/**
+ * @brief Sets the callback of one Timer 2 event and enables its interrupt.
+ *
+ * @param a_event The event.
+ * @param a_ptr2func Pointer to the callback function, or NULL_PTR to remove it
+ *                   and disable the interrupt.
+ */
+void Timer2_setCallback(Timer2_Event a_event, void (*a_ptr2func)(void));
+
+/**
+ * @brief Returns the current Timer 2 count (TCNT2).
+ */
+uint8 Timer2_getCount(void);
+
+/**
+ * @brief Tells whether a compare match is still waiting for its interrupt.
+ *
+ * Reads OCF2 without clearing it, for code that runs with interrupts disabled.
+ *
+ * @return TRUE if OCF2 is set.
+ */
+boolean Timer2_isComparePending(void);
+
+/**
+ * @brief Runs the compare callback if a match is pending, without the interrupt.
+ *
+ * For code that has to wait on the timer while global interrupts are disabled.
+ *
+ * @return TRUE if a match was pending and the callback was run, FALSE otherwise.
+ */
+boolean Timer2_pollCompare(void);
+
+/**
+ * @brief Stops Timer 2 and disables its interrupts.
+ */
+void Timer2_deInit(void);
+
+#endif /* TIMER_2_H_ */
@@ -0,0 +1,229 @@
+/**
+ * @file scheduler.c
+ * @brief Time-triggered cooperative task scheduler on the software timer tick.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ *
+ * @see scheduler.h
+ * @see soft_timer.h
+ */
+
+#include "scheduler.h"
+#include "soft_timer.h"
+#ifdef SCHEDULER_IDLE_SLEEP
+#include "../mcal/power.h"
+#endif
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief One entry of the task table.
+ */
+typedef struct {
+    void (*task)(void);
+    uint16 period;
+    uint16 countdown;        /**< Ticks left until the task is due, counted by the ISR */
+    uint8 priority;
+    volatile boolean pending; /**< Set by the ISR, cleared when the task runs */
+} Scheduler_Task;
+
+/*******************************************************************************
+ *                                Global Variables                             *
+ *******************************************************************************/
+
+/* Sorted by priority, so the dispatcher runs the first pending entry */
+static Scheduler_Task g_tasks[SCHEDULER_MAX_TASKS];
+static uint8 g_taskCount;
+
+/* Periodic software timer giving the tick */
+static SoftTimer g_tickTimer;
+
+static volatile uint16 g_ticks;
+static volatile uint16 g_overruns;
+
+/* Idle time of the current load window, in Timer 2 counts */
+static uint32 g_idleCounts;
+static uint16 g_windowStart;
+static uint8 g_idlePercent;
+
+/*******************************************************************************
+ *                                Functions Definitions                        *
+ *******************************************************************************/
+
+/**
+ * @brief Software timer callback: marks the due tasks.
+ */
+static void Scheduler_onTick(void) {
+    uint8 i;
+
+    g_ticks++;
+    for (i = 0; i < g_taskCount; i++) {
+        if (--g_tasks[i].countdown == 0) {
+            g_tasks[i].countdown = g_tasks[i].period;
+            if (!g_tasks[i].pending) {
+                g_tasks[i].pending = TRUE;
+            } else if (g_overruns != 0xFFFF) {
+                g_overruns++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Closes the load window once it is complete and publishes its idle share.
+ */
+static void Scheduler_updateLoad(uint16 a_now) {
+    uint16 l_elapsed = a_now - g_windowStart;
+    uint32 l_percent;
+
+    if (l_elapsed < SCHEDULER_LOAD_WINDOW_TICKS) {
+        return;
+    }
+    l_percent = g_idleCounts * 100 / ((uint32) l_elapsed * SOFT_TIMER_COUNTS_PER_TICK);
+    g_idlePercent = (l_percent > 100) ? 100 : (uint8) l_percent;
+    g_idleCounts = 0;
+    g_windowStart = a_now;
+}
+
+/**
+ * @brief Clears the task table.
+ */
+void Scheduler_init(void) {
+    g_taskCount = 0;
+}
+
+/**
+ * @brief Adds a task to the table, behind the tasks of the same or higher priority.
+ *
+ * @param a_task The task function.
+ * @param a_period Period in ticks (1 or more).
+ * @param a_offset Ticks before the first run.
+ * @param a_priority 0 is the highest.
+ * @return TRUE if the task was added, FALSE if the table is full.
+ */
+boolean Scheduler_addTask(void (*a_task)(void), uint16 a_period, uint16 a_offset,
+        uint8 a_priority) {
+    uint8 l_sreg = SREG;
+    uint8 i;
+
+    if (g_taskCount == SCHEDULER_MAX_TASKS || a_task == NULL_PTR || a_period == 0) {
+        return FALSE;
+    }
+
+    cli();
+    for (i = g_taskCount; i > 0 && g_tasks[i - 1].priority > a_priority; i--) {
+        g_tasks[i] = g_tasks[i - 1];
+    }
+    g_tasks[i].task = a_task;
+    g_tasks[i].period = a_period;
+    g_tasks[i].countdown = a_offset + 1;
+    g_tasks[i].priority = a_priority;
+    g_tasks[i].pending = FALSE;
+    g_taskCount++;
+    SREG = l_sreg;
+    return TRUE;
+}
+
+/**
+ * @brief Starts the tick.
+ */
+void Scheduler_start(void) {
+    uint8 l_sreg = SREG;
+
+    cli();
+    g_ticks = 0;
+    g_overruns = 0;
+    g_windowStart = 0;
+    g_idleCounts = 0;
+    g_idlePercent = 100;
+    SoftTimer_start(&g_tickTimer, Scheduler_onTick, 1, 1);
+    SREG = l_sreg;
+}
+
+/**
+ * @brief Runs the highest priority task that is due, or waits for the next tick.
+ *
+ * One task per call: the table is scanned from the top again afterwards, so a
+ * higher priority task that fell due in the meantime goes first.
+ */
+void Scheduler_dispatch(void) {
+    uint16 l_tick = Scheduler_getTicks();
+    uint16 l_startTick;
+    uint16 l_endTick;
+    uint8 l_startPhase;
+    uint8 l_endPhase;
+    uint8 i;
+
+    Scheduler_updateLoad(l_tick);
+    for (i = 0; i < g_taskCount; i++) {
+        if (g_tasks[i].pending) {
+            g_tasks[i].pending = FALSE;
+            g_tasks[i].task();
+            return;
+        }
+    }
+
+    /* Nothing due: wait for the tick read above to be followed by the next one */
+    l_startTick = SoftTimer_getTime(&l_startPhase);
+#ifdef SCHEDULER_IDLE_SLEEP
+    for (;;) {
+        cli();
+        if (g_ticks != l_tick) {
+            break;
+        }
+        /* Any interrupt wakes the CPU; only a tick ends the wait */
+        Power_sleep(POWER_SLEEP_IDLE);
+    }
+    sei();
+#else
+    while (Scheduler_getTicks() == l_tick) {
+    }
+#endif
+    l_endTick = SoftTimer_getTime(&l_endPhase);
+    g_idleCounts += (uint32) (uint16) (l_endTick - l_startTick) * SOFT_TIMER_COUNTS_PER_TICK
+            + l_endPhase - l_startPhase;
+}
+
+/**
+ * @brief Returns the number of ticks since Scheduler_start().
+ *
+ * The count is 16 bits wide, so interrupts are held off for the two byte reads.
+ */
+uint16 Scheduler_getTicks(void) {
+    uint8 l_sreg = SREG;
+    uint16 l_ticks;
+
+    cli();
+    l_ticks = g_ticks;
+    SREG = l_sreg;
+    return l_ticks;
+}
+
+/**
+ * @brief Returns the share of the last full load window spent waiting for a tick.
+ *
+ * Interrupts that run during the wait count as idle time.
+ *
+ * @return Idle time in percent (0-100).
+ */
+uint8 Scheduler_getIdlePercent(void) {
+    return g_idlePercent;
+}
+
+/**
+ * @brief Returns how many times a task was still due when its next period came.
+ */
+uint16 Scheduler_getOverruns(void) {
+    uint8 l_sreg = SREG;
+    uint16 l_overruns;
+
+    cli();
+    l_overruns = g_overruns;
+    SREG = l_sreg;
+    return l_overruns;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file scheduler.h
+ * @brief Time-triggered cooperative task scheduler.
+ *
+ * A periodic software timer gives the tick, so the scheduler shares the Timer 2
+ * timebase of soft_timer.h with the other timed services. Each task has a
+ * period and an offset in ticks and a priority. The tick interrupt only counts
+ * down and marks the tasks that are due; Scheduler_dispatch(), called from the
+ * main loop, runs them to completion, highest priority first, and waits for the
+ * next tick when nothing is due. The wait is spent in Idle sleep (unless
+ * SCHEDULER_IDLE_SLEEP is undefined) and measured in Timer 2 counts, so the CPU
+ * load of the tasks can be read back.
+ *
+ * Tasks never preempt each other: a long task delays the others, and a tick that
+ * finds a task still due counts as an overrun.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include "../common/std_types.h"
+#include "soft_timer.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Sleep in Idle mode between ticks instead of polling the tick count.
+ *
+ * Idle mode keeps the timers running. ADC Noise Reduction mode would stop the
+ * Timer 2 tick, so it is not used here.
+ */
+#define SCHEDULER_IDLE_SLEEP
+
+/**
+ * @brief Largest number of tasks.
+ */
+#define SCHEDULER_MAX_TASKS 8
+
+/**
+ * @brief Tick period in microseconds: one software timer tick.
+ */
+#define SCHEDULER_TICK_US SOFT_TIMER_TICK_US
+
+/**
+ * @brief Converts a time in milliseconds to scheduler ticks.
+ */
+#define SCHEDULER_MS_TO_TICKS(ms) ((uint16) ((ms) * 1000UL / SCHEDULER_TICK_US))
+
+/**
+ * @brief Ticks over which the idle time is measured (one second).
+ */
+#define SCHEDULER_LOAD_WINDOW_TICKS SCHEDULER_MS_TO_TICKS(1000)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/**
+ * @brief Clears the task table.
+ *
+ * The tick does not run until Scheduler_start().
+ */
+void Scheduler_init(void);
+
+/**
+ * @brief Adds a task to the table.
+ *
+ * @param a_task The task function; it must return, and should return quickly.
+ * @param a_period Period in ticks (1 or more).
+ * @param a_offset Ticks before the first run, to spread tasks of the same period.
+ * @param a_priority 0 is the highest; tasks due on the same tick run in this order.
+ * @return TRUE if the task was added, FALSE if the table is full.
+ */
+boolean Scheduler_addTask(void (*a_task)(void), uint16 a_period, uint16 a_offset,
+        uint8 a_priority);
+
+/**
+ * @brief Starts the tick.
+ *
+ * SoftTimer_init() must have been called first.
+ */
+void Scheduler_start(void);
+
+/**
+ * @brief Runs the tasks that are due, then waits for the next tick.
+ *
+ * Call it from the main loop. Global interrupts must be enabled.
+ */
+void Scheduler_dispatch(void);
+
+/**
+ * @brief Returns the number of ticks since Scheduler_start() (wraps at 65536).
+ */
+uint16 Scheduler_getTicks(void);
+
+/**
+ * @brief Returns the share of the last full load window spent waiting for a tick.
+ *
+ * With SCHEDULER_IDLE_SLEEP this is the time asleep, plus the interrupts that
+ * woke the CPU.
+ *
+ * @return Idle time in percent (0-100), 100 before the first window ends.
+ */
+uint8 Scheduler_getIdlePercent(void);
+
+/**
+ * @brief Returns how many times a task was still due when its next period came.
+ */
+uint16 Scheduler_getOverruns(void);
+
+#endif /* SCHEDULER_H_ */
@@ -0,0 +1,213 @@
+/**
+ * @file soft_timer.c
+ * @brief Software timers in a hashed timer wheel, driven by a Timer 2 tick.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ *
+ * @see soft_timer.h
+ * @see timer_2.h
+ */
+
+#include "soft_timer.h"
+#include "../mcal/timer_2.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SOFT_TIMER_WHEEL_MASK (SOFT_TIMER_WHEEL_SIZE - 1)
+
+#if (SOFT_TIMER_WHEEL_SIZE & SOFT_TIMER_WHEEL_MASK) != 0
+#error "SOFT_TIMER_WHEEL_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+ *                                Global Variables                             *
+ *******************************************************************************/
+
+/* Slot i holds the running timers whose expiry is i modulo the wheel size */
+static SoftTimer *g_wheel[SOFT_TIMER_WHEEL_SIZE];
+
+static volatile uint16 g_ticks;
+
+/* Next timer of the slot being walked, moved on if a callback stops that timer */
+static SoftTimer *g_walkNext;
+
+/*******************************************************************************
+ *                                Functions Definitions                        *
+ *******************************************************************************/
+
+/**
+ * @brief Puts a timer at the head of the slot of its expiry tick.
+ *
+ * At the head, a timer added to the slot being walked is only seen a full turn
+ * later. Interrupts must be disabled.
+ */
+static void SoftTimer_link(SoftTimer *a_timer, uint16 a_expiry) {
+    SoftTimer **l_slot = &g_wheel[a_expiry & SOFT_TIMER_WHEEL_MASK];
+
+    a_timer->expiry = a_expiry;
+    a_timer->next = *l_slot;
+    if (*l_slot != NULL_PTR) {
+        (*l_slot)->link = &a_timer->next;
+    }
+    *l_slot = a_timer;
+    a_timer->link = l_slot;
+}
+
+/**
+ * @brief Takes a running timer out of its slot. Interrupts must be disabled.
+ */
+static void SoftTimer_unlink(SoftTimer *a_timer) {
+    if (a_timer == g_walkNext) {
+        g_walkNext = a_timer->next;
+    }
+    *a_timer->link = a_timer->next;
+    if (a_timer->next != NULL_PTR) {
+        a_timer->next->link = a_timer->link;
+    }
+    a_timer->link = NULL_PTR;
+}
+
+/**
+ * @brief Timer 2 compare callback: advances the tick and fires the timers due on it.
+ */
+static void SoftTimer_onTick(void) {
+    uint16 l_now = ++g_ticks;
+    SoftTimer *l_timer = g_wheel[l_now & SOFT_TIMER_WHEEL_MASK];
+
+    /* Timers of later turns share the slot and are only skipped */
+    while (l_timer != NULL_PTR) {
+        g_walkNext = l_timer->next;
+        if (l_timer->expiry == l_now) {
+            SoftTimer_unlink(l_timer);
+            if (l_timer->period != 0) {
+                SoftTimer_link(l_timer, l_now + l_timer->period);
+            }
+            l_timer->callback();
+        }
+        l_timer = g_walkNext;
+    }
+}
+
+/**
+ * @brief Empties the wheel and starts the Timer 2 tick.
+ */
+void SoftTimer_init(void) {
+    Timer2_Config l_timerConfig = { TIMER2_MODE_CTC, TIMER2_PRESCALER_64,
+            TIMER2_CTC_COMPARE(SOFT_TIMER_TICK_US, SOFT_TIMER_PRESCALER) };
+    uint8 i;
+
+    for (i = 0; i < SOFT_TIMER_WHEEL_SIZE; i++) {
+        g_wheel[i] = NULL_PTR;
+    }
+    g_ticks = 0;
+    g_walkNext = NULL_PTR;
+    Timer2_init(&l_timerConfig);
+    Timer2_setCallback(TIMER2_EVENT_COMPARE, SoftTimer_onTick);
+}
+
+/**
+ * @brief Starts a timer, or restarts it if it is running.
+ *
+ * @param a_timer The timer.
+ * @param a_callback Function run when the timer fires.
+ * @param a_delay Ticks before the first run (0 is taken as 1).
+ * @param a_period Ticks between later runs, or 0 for a one-shot timer.
+ */
+void SoftTimer_start(SoftTimer *a_timer, void (*a_callback)(void), uint16 a_delay,
+        uint16 a_period) {
+    uint8 l_sreg = SREG;
+
+    if (a_delay == 0) {
+        a_delay = 1;
+    }
+
+    cli();
+    if (a_timer->link != NULL_PTR) {
+        SoftTimer_unlink(a_timer);
+    }
+    a_timer->callback = a_callback;
+    a_timer->period = a_period;
+    SoftTimer_link(a_timer, g_ticks + a_delay);
+    SREG = l_sreg;
+}
+
+/**
+ * @brief Stops a timer; nothing happens if it is not running.
+ *
+ * @param a_timer The timer.
+ */
+void SoftTimer_stop(SoftTimer *a_timer) {
+    uint8 l_sreg = SREG;
+
+    cli();
+    if (a_timer->link != NULL_PTR) {
+        SoftTimer_unlink(a_timer);
+    }
+    SREG = l_sreg;
+}
+
+/**
+ * @brief Tells whether a timer is running.
+ *
+ * @param a_timer The timer.
+ */
+boolean SoftTimer_isRunning(const SoftTimer *a_timer) {
+    return (a_timer->link != NULL_PTR) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Advances the tick from the compare flag while interrupts are disabled.
+ */
+void SoftTimer_poll(void) {
+    Timer2_pollCompare();
+}
+
+/**
+ * @brief Returns the number of ticks since SoftTimer_init().
+ *
+ * The count is 16 bits wide, so interrupts are held off for the two byte reads.
+ */
+uint16 SoftTimer_getTicks(void) {
+    uint8 l_sreg = SREG;
+    uint16 l_ticks;
+
+    cli();
+    l_ticks = g_ticks;
+    SREG = l_sreg;
+    return l_ticks;
+}
+
+/**
+ * @brief Returns the tick count and the Timer 2 count within the tick, read together.
+ *
+ * The tick interrupt comes when OCF2 is set, on TCNT2 = OCR2, so that count is
+ * phase 0 of the new tick and the phase is TCNT2 + 1 modulo the tick. OCF2 stays
+ * set until the interrupt runs: with the flag set, a phase from the first half of
+ * the tick was read after the match, so the pending tick is added.
+ *
+ * @param a_phase Receives the Timer 2 count within the tick.
+ * @return The number of ticks since SoftTimer_init().
+ */
+uint16 SoftTimer_getTime(uint8 *a_phase) {
+    uint8 l_sreg = SREG;
+    uint16 l_ticks;
+    uint8 l_phase;
+
+    cli();
+    l_phase = Timer2_getCount() + 1;
+    if (l_phase == SOFT_TIMER_COUNTS_PER_TICK) {
+        l_phase = 0;
+    }
+    l_ticks = g_ticks;
+    if (Timer2_isComparePending() && l_phase < SOFT_TIMER_COUNTS_PER_TICK / 2) {
+        l_ticks++;
+    }
+    SREG = l_sreg;
+    *a_phase = l_phase;
+    return l_ticks;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file soft_timer.h
+ * @brief Software timers on a Timer 2 tick, kept in a hashed timer wheel.
+ *
+ * Timer 2 interrupts every SOFT_TIMER_TICK_US. The running timers hang in
+ * SOFT_TIMER_WHEEL_SIZE lists, each one holding the timers whose expiry tick has
+ * the same low bits, and a tick only walks the list of its own slot. Starting and
+ * stopping a timer is a list insert or unlink, and a tick costs only the timers
+ * that share its slot, about one per slot while there are no more timers than
+ * slots.
+ *
+ * The timers are owned by the caller, so there is no fixed limit; a timer must
+ * start zeroed, as static ones are. Callbacks run in the Timer 2 interrupt with
+ * interrupts disabled: they must be short, and may start or stop any timer,
+ * including their own.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SOFT_TIMER_H_
+#define SOFT_TIMER_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Tick period in microseconds (Timer 2 CTC, prescaler 64, 250 counts).
+ */
+#define SOFT_TIMER_TICK_US 1000
+
+/**
+ * @brief Timer 2 prescaler, and the Timer 2 counts in one tick (4 us each).
+ */
+#define SOFT_TIMER_PRESCALER      64
+#define SOFT_TIMER_COUNTS_PER_TICK ((uint16) ((F_CPU / 1000000UL) * SOFT_TIMER_TICK_US \
+        / SOFT_TIMER_PRESCALER))
+
+/**
+ * @brief Number of wheel slots, a power of two.
+ *
+ * More slots than running timers keeps most slots at one timer or none.
+ */
+#define SOFT_TIMER_WHEEL_SIZE 32
+
+/**
+ * @brief Converts a time in milliseconds to soft timer ticks.
+ */
+#define SOFT_TIMER_MS_TO_TICKS(ms) ((uint16) ((ms) * 1000UL / SOFT_TIMER_TICK_US))
+
+/**
+ * @brief A software timer. The fields are private to soft_timer.c.
+ */
+typedef struct SoftTimer {
+    struct SoftTimer *next;   /**< Next timer in the same wheel slot */
+    struct SoftTimer **link;  /**< The pointer to this timer, NULL_PTR when stopped */
+    void (*callback)(void);
+    uint16 expiry;            /**< Tick at which the timer fires */
+    uint16 period;            /**< Ticks between runs, 0 for a one-shot timer */
+} SoftTimer;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/**
+ * @brief Empties the wheel and starts the Timer 2 tick.
+ *
+ * Global interrupts must be enabled for the timers to run.
+ */
+void SoftTimer_init(void);
+
+/**
+ * @brief Starts a timer, or restarts it if it is running.
+ *
+ * @param a_timer The timer.
+ * @param a_callback Function run when the timer fires.
+ * @param a_delay Ticks before the first run (1 to 0xFFFF; 0 is taken as 1).
+ * @param a_period Ticks between later runs, or 0 for a one-shot timer.
+ */
+void SoftTimer_start(SoftTimer *a_timer, void (*a_callback)(void), uint16 a_delay,
+        uint16 a_period);
+
+/**
+ * @brief Stops a timer; nothing happens if it is not running.
+ *
+ * @param a_timer The timer.
+ */
+void SoftTimer_stop(SoftTimer *a_timer);
+
+/**
+ * @brief Tells whether a timer is running (a one-shot timer stops when it fires).
+ *
+ * @param a_timer The timer.
+ */
+boolean SoftTimer_isRunning(const SoftTimer *a_timer);
+
+/**
+ * @brief Advances the tick, and fires the timers due on it, if its interrupt is pending.
+ *
+ * For code that waits on a timer while global interrupts are disabled (e.g.
+ * before sei() at startup); call it in the wait loop.
+ */
+void SoftTimer_poll(void);
+
+/**
+ * @brief Returns the number of ticks since SoftTimer_init() (wraps at 65536).
+ */
+uint16 SoftTimer_getTicks(void);
+
+/**
+ * @brief Returns the tick count and how far the current tick has gone, read together.
+ *
+ * A tick whose interrupt is still pending (the caller has interrupts disabled, or
+ * runs in a higher-priority interrupt) is already counted, so the time never goes
+ * back. (ticks * SOFT_TIMER_COUNTS_PER_TICK + phase) times elapsed spans shorter
+ * than 65536 ticks finer than the tick.
+ *
+ * @param a_phase Receives the Timer 2 count within the tick, 0 to
+ *        SOFT_TIMER_COUNTS_PER_TICK - 1.
+ * @return The number of ticks since SoftTimer_init() (wraps at 65536).
+ */
+uint16 SoftTimer_getTime(uint8 *a_phase);
+
+#endif /* SOFT_TIMER_H_ */
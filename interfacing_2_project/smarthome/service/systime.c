@@ -0,0 +1,171 @@
+/**
+ * @file systime.c
+ * @brief Monotonic system clock on the Timer 1 timebase.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ *
+ * @see systime.h
+ * @see timer_1.h
+ */
+
+#include "systime.h"
+#include "../mcal/timer_1.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/**
+ * @brief Length of one Timer 1 wrap: 32768 us at 16 MHz, 32 ms and 768 us.
+ */
+#define SYSTIME_US_PER_WRAP       (65536UL / TIMER1_TICKS_PER_US)
+#define SYSTIME_MS_PER_WRAP       (SYSTIME_US_PER_WRAP / 1000)
+#define SYSTIME_US_REMAINDER_WRAP (SYSTIME_US_PER_WRAP % 1000)
+
+#if (65536UL % TIMER1_TICKS_PER_US) != 0
+#error "A Timer 1 wrap must be a whole number of microseconds"
+#endif
+
+/*******************************************************************************
+ *                                Global Variables                             *
+ *******************************************************************************/
+
+/* Time at the last wrap: in microseconds, and in milliseconds plus the rest */
+static uint32 g_wrapMicros;
+static uint32 g_wrapMillis;
+static uint16 g_wrapRemainderUs;
+
+/* Clock readings at SysTime_init(), taken off every timestamp */
+static uint32 g_startMicros;
+static uint32 g_startMillis;
+static boolean g_running = FALSE;
+
+/*******************************************************************************
+ *                                Functions Definitions                        *
+ *******************************************************************************/
+
+/**
+ * @brief Adds one wrap to the clock. Interrupts must be disabled.
+ */
+static void SysTime_addWrap(void) {
+    g_wrapMicros += SYSTIME_US_PER_WRAP;
+    g_wrapMillis += SYSTIME_MS_PER_WRAP;
+    g_wrapRemainderUs += SYSTIME_US_REMAINDER_WRAP;
+    if (g_wrapRemainderUs >= 1000) {
+        g_wrapRemainderUs -= 1000;
+        g_wrapMillis++;
+    }
+}
+
+/**
+ * @brief Reads the timebase, counting a wrap whose overflow interrupt has not run
+ * yet. Interrupts must be disabled.
+ *
+ * TOV1 is set while a wrap waits for TIMER1_OVF_vect, which a reader with
+ * interrupts disabled, or in a higher-priority interrupt (input capture, Timer 2),
+ * can see first. A low count was read after that wrap: the wrap is counted here
+ * and the flag cleared, so the interrupt does not count it again. A high count
+ * was read just before the wrap, which stays with the interrupt.
+ *
+ * @return The Timer 1 count.
+ */
+static uint16 SysTime_update(void) {
+    uint16 l_count = Timer1_getCount();
+
+    if (Timer1_isOverflowPending() && l_count < 0x8000) {
+        SysTime_addWrap();
+        Timer1_clearOverflow();
+    }
+    return l_count;
+}
+
+/**
+ * @brief Timer 1 overflow callback: counts the wrap.
+ */
+static void SysTime_onOverflow(void) {
+    SysTime_addWrap();
+}
+
+/**
+ * @brief Starts the clock on the Timer 1 timebase.
+ */
+void SysTime_init(void) {
+    Timer1_Config l_timerConfig = { TIMER1_MODE_NORMAL, TIMER1_PRESCALER_8 };
+    uint8 l_sreg;
+    uint16 l_count;
+    uint16 l_us;
+
+    if (g_running) {
+        return;
+    }
+    Timer1_init(&l_timerConfig);
+
+    l_sreg = SREG;
+    cli();
+    g_wrapMicros = 0;
+    g_wrapMillis = 0;
+    g_wrapRemainderUs = 0;
+    /* A wrap from before the clock started is not counted */
+    Timer1_clearOverflow();
+    l_count = Timer1_getCount();
+    l_us = l_count / TIMER1_TICKS_PER_US;
+    g_startMicros = l_us;
+    g_startMillis = l_us / 1000;
+    Timer1_setCallback(TIMER1_EVENT_OVERFLOW, SysTime_onOverflow);
+    Timer1_setEventInterrupt(TIMER1_EVENT_OVERFLOW, TRUE);
+    g_running = TRUE;
+    SREG = l_sreg;
+}
+
+/**
+ * @brief Returns the milliseconds since SysTime_init().
+ */
+uint32 SysTime_millis(void) {
+    uint8 l_sreg = SREG;
+    uint32 l_millis;
+    uint16 l_us;
+
+    cli();
+    l_us = SysTime_update() / TIMER1_TICKS_PER_US;
+    /* Below 1000 + 32768, so the division stays 16 bits wide */
+    l_millis = g_wrapMillis + (uint16) (g_wrapRemainderUs + l_us) / 1000;
+    SREG = l_sreg;
+    return l_millis - g_startMillis;
+}
+
+/**
+ * @brief Returns the microseconds since SysTime_init().
+ */
+uint32 SysTime_micros(void) {
+    uint8 l_sreg = SREG;
+    uint32 l_micros;
+
+    cli();
+    l_micros = g_wrapMicros + SysTime_update() / TIMER1_TICKS_PER_US;
+    SREG = l_sreg;
+    return l_micros - g_startMicros;
+}
+
+/**
+ * @brief Converts a Timer 1 count of the last 32.768 ms to a microsecond timestamp.
+ *
+ * @param a_count The Timer 1 count.
+ */
+uint32 SysTime_microsAt(uint16 a_count) {
+    uint8 l_sreg = SREG;
+    uint32 l_micros;
+    uint16 l_now;
+
+    cli();
+    l_now = SysTime_update();
+    l_micros = g_wrapMicros + a_count / TIMER1_TICKS_PER_US;
+    /* A count above the current one was taken before the last wrap */
+    if (a_count > l_now) {
+        l_micros -= SYSTIME_US_PER_WRAP;
+    }
+    SREG = l_sreg;
+    return l_micros - g_startMicros;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file systime.h
+ * @brief Monotonic system clock with millisecond and microsecond timestamps.
+ *
+ * The clock extends the free-running Timer 1 timebase (0.5 us counts) with a count
+ * of its wraps. The Timer 1 overflow interrupt counts
+ * them; a reader that comes between a wrap and its interrupt (interrupts disabled,
+ * or a higher-priority ISR) finds the overflow flag set with a low count, counts
+ * the wrap itself and clears the flag. So the clock is right in interrupt context
+ * too, as long as interrupts are never held off for half a wrap (16.384 ms).
+ *
+ * Both clocks wrap (micros after 71.6 minutes, millis after 49.7 days). Compare
+ * timestamps by unsigned subtraction, which stays right across the wrap:
+ *
+ *     if (SysTime_millis() - l_start >= TIMEOUT_MS) { ... }
+ *
+ * ADC Noise Reduction sleep stops Timer 1, and the clock with it.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#ifndef SYSTIME_H_
+#define SYSTIME_H_
+
+#include "../common/std_types.h"
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/**
+ * @brief Starts the clock on the Timer 1 timebase, starting the timebase if needed.
+ *
+ * Every driver that needs the clock may call this: once the clock runs, further
+ * calls do nothing. Global interrupts must be enabled for the clock to keep counting.
+ */
+void SysTime_init(void);
+
+/**
+ * @brief Returns the milliseconds since SysTime_init().
+ */
+uint32 SysTime_millis(void);
+
+/**
+ * @brief Returns the microseconds since SysTime_init().
+ */
+uint32 SysTime_micros(void);
+
+/**
+ * @brief Converts a Timer 1 count taken by the hardware, such as an input capture
+ * (ICR1), to a microsecond timestamp.
+ *
+ * The count must be less than one wrap (32.768 ms) old.
+ *
+ * @param a_count The Timer 1 count.
+ * @return The time of that count, on the SysTime_micros() clock.
+ */
+uint32 SysTime_microsAt(uint16 a_count);
+
+#endif /* SYSTIME_H_ */
@@ -0,0 +1,93 @@
+/**
+ * @file gen_sensor_tables.c
+ * @brief Generates hal/sensor_tables.c, the ADC code to sensor reading tables.
+ *
+ * Built and run on the PC by `make -C host tables`. The sensor constants come
+ * from the firmware headers, so the tables follow any change made there.
+ *
+ * @date 16 Oct 2026
+ * @author Ibrahim Mohsen
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "../hal/lm35_sensor.h"
+#include "../hal/ldr.h"
+#include "../hal/sensor_tables.h"
+
+/* The firmware sources use CRLF line endings */
+#define EOL "\r\n"
+
+#define VALUES_PER_LINE 16
+
+/**
+ * @brief LM35 temperature for an ADC code, truncated like the original formula.
+ */
+static unsigned lm35Degrees(unsigned a_code)
+{
+    unsigned long l_degrees = (unsigned long) a_code * SENSOR_MAX_TEMPERATURE * ADC_REF_VOLT_MV
+            / ((unsigned long) ADC_MAXIMUM_VALUE * SENSOR_MAX_VOLT_MV);
+
+    return l_degrees > 255 ? 255 : (unsigned) l_degrees;
+}
+
+/**
+ * @brief Divider ratio R_fixed / R_ldr seen at an ADC code, which is proportional
+ * to a power of the illuminance.
+ */
+static double ldrRatio(unsigned a_code)
+{
+    double l_supplyCode = (double) ADC_MAXIMUM_VALUE * LDR_SUPPLY_MV / ADC_REF_VOLT_MV;
+
+    return a_code / (l_supplyCode - a_code);
+}
+
+/**
+ * @brief LDR light intensity in percent for an ADC code, rounded.
+ */
+static unsigned ldrPercent(unsigned a_code)
+{
+    if (a_code <= LDR_DARK_CODE)
+        return 0;
+    if (a_code >= LDR_BRIGHT_CODE)
+        return 100;
+    return (unsigned) lround(100.0 * log(ldrRatio(a_code) / ldrRatio(LDR_DARK_CODE))
+            / log(ldrRatio(LDR_BRIGHT_CODE) / ldrRatio(LDR_DARK_CODE)));
+}
+
+/**
+ * @brief Prints one table definition.
+ */
+static void printTable(const char *a_name, const char *a_comment, unsigned (*a_value)(unsigned))
+{
+    unsigned l_code;
+
+    printf("/* %s */" EOL, a_comment);
+    printf("const uint8 %s[SENSOR_TABLE_SIZE] PROGMEM = {" EOL, a_name);
+    for (l_code = 0; l_code < SENSOR_TABLE_SIZE; l_code++)
+    {
+        if (l_code % VALUES_PER_LINE == 0)
+            printf("   ");
+        printf(" %3u%s", a_value(l_code), l_code + 1 < SENSOR_TABLE_SIZE ? "," : "");
+        if (l_code % VALUES_PER_LINE == VALUES_PER_LINE - 1)
+            printf(EOL);
+    }
+    printf("};" EOL);
+}
+
+int main(void)
+{
+    printf("/**" EOL
+            " * @file sensor_tables.c" EOL
+            " * @brief ADC code to sensor reading tables." EOL
+            " *" EOL
+            " * Generated by tools/gen_sensor_tables.c (make -C host tables), do not edit." EOL
+            " */" EOL
+            EOL
+            "#include \"sensor_tables.h\"" EOL
+            EOL);
+    printTable("g_lm35DegreesTable", "LM35 temperature in degrees Celsius", lm35Degrees);
+    printf(EOL);
+    printTable("g_ldrPercentTable", "LDR light intensity in percent", ldrPercent);
+    return 0;
+}